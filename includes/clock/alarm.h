@@ -0,0 +1,81 @@
+#ifndef ALARM_H
+#define ALARM_H
+
+#include <stdint.h>
+
+/*
+ * Alarm timing wheel
+ *   Hierarchical wheel of ALARM_WHEEL_LEVELS x ALARM_WHEEL_SLOTS buckets
+ *   driven by the clock's 1 s tick. Alarms live in a fixed pool and are
+ *   linked into a bucket by index, so add and cancel are O(1) and a tick
+ *   only touches the one level-0 bucket that is due (plus an amortized
+ *   cascade every 64 ticks), however many alarms are loaded.
+ *
+ *   Per-level occupancy bitmaps let alarm_wheel_next find the next tick
+ *   with work without scanning, so a tickless caller can sleep until then.
+ */
+
+#define ALARM_WHEEL_BITS     6
+#define ALARM_WHEEL_SLOTS    (1 << ALARM_WHEEL_BITS)
+#define ALARM_WHEEL_LEVELS   4
+#define ALARM_MAX_DELAY      ((1ull << (ALARM_WHEEL_BITS * ALARM_WHEEL_LEVELS)) - 1)   // ~194 days
+#define ALARM_MAX            4096
+#define ALARM_NEVER          UINT64_MAX
+
+#define ALARM_ID_NONE        0u
+
+typedef uint32_t alarm_id_t;   // generation << 16 | pool index
+
+typedef enum {
+    ALARM_ACTION_LED_PATTERN,  // arg = LED pattern, lasts duration ticks
+    ALARM_ACTION_HEX_FLASH,    // flash the HEX displays for duration ticks
+    ALARM_ACTION_CALLBACK      // call callback(ctx, id)
+} alarm_action_t;
+
+typedef void (*alarm_callback_t)(void *ctx, alarm_id_t id);
+
+typedef struct {
+    alarm_action_t action;
+    uint32_t arg;
+    uint32_t duration;         // ticks
+    uint32_t period;           // re-arm interval in ticks; 0 = one-shot
+    alarm_callback_t callback;
+    void *ctx;
+} alarm_spec_t;
+
+typedef struct {
+    uint64_t expires;
+    int32_t next;              // bucket list links (pool indices, -1 = end)
+    int32_t prev;
+    int16_t bucket;            // level * ALARM_WHEEL_SLOTS + slot; -1 when free
+    uint16_t generation;
+    alarm_spec_t spec;
+} alarm_t;
+
+// Invoked for every expiry; the wheel may be modified from inside.
+typedef void (*alarm_fire_fn)(void *ctx, alarm_id_t id, const alarm_spec_t *spec);
+
+typedef struct {
+    uint64_t now;              // last processed tick
+    int32_t heads[ALARM_WHEEL_LEVELS * ALARM_WHEEL_SLOTS];
+    uint64_t occupied[ALARM_WHEEL_LEVELS];
+    alarm_t pool[ALARM_MAX];
+    int32_t free_head;
+    uint32_t active;
+    alarm_fire_fn on_fire;
+    void *ctx;
+} alarm_wheel_t;
+
+//* Setup
+void alarm_wheel_init(alarm_wheel_t *w, uint64_t now_tick, alarm_fire_fn on_fire, void *ctx);
+
+//* Insert & cancel (O(1))
+alarm_id_t alarm_add(alarm_wheel_t *w, uint64_t expires_tick, const alarm_spec_t *spec);
+int alarm_cancel(alarm_wheel_t *w, alarm_id_t id);
+
+//* Drive
+void alarm_wheel_tick(alarm_wheel_t *w);
+void alarm_wheel_advance(alarm_wheel_t *w, uint64_t target_tick);
+uint64_t alarm_wheel_next(const alarm_wheel_t *w);
+
+#endif // ALARM_H
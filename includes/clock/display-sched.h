@@ -0,0 +1,55 @@
+#ifndef DISPLAY_SCHED_H
+#define DISPLAY_SCHED_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Display-aware tickless scheduler
+ *   Each thing that can change the rendered output registers a "source":
+ *   a period and a phase (e.g. minute boundaries of the wall clock, blink
+ *   half-periods, animation frames), or a one-shot deadline. The main loop
+ *   sleeps until the earliest boundary of an enabled source, so it only
+ *   wakes when the visible output can actually differ.
+ */
+
+#define DISPLAY_SCHED_MAX_SOURCES   8
+#define DISPLAY_SCHED_REPORT_NS     (3600ull * 1000000000ull)   // hourly stats
+#define DISPLAY_SCHED_NEVER         UINT64_MAX
+
+typedef struct {
+    uint64_t period_ns;
+    uint64_t phase_ns;      // boundaries fall on phase_ns + k * period_ns
+    int enabled;
+} display_source_t;
+
+typedef struct {
+    display_source_t sources[DISPLAY_SCHED_MAX_SOURCES];
+    int source_count;
+    uint64_t deadline_ns;   // one-shot wake, DISPLAY_SCHED_NEVER if none
+    uint64_t woke_for_ns;   // deadline of the last completed wait (for overrun stats)
+
+    // Wakeup accounting
+    uint64_t start_ns;
+    uint64_t start_cpu_ns;
+    uint64_t total_wakeups;
+    uint64_t window_start_ns;
+    uint64_t window_cpu_ns;
+    uint64_t window_wakeups;
+} display_sched_t;
+
+//* Setup
+void display_sched_init(display_sched_t *s, uint64_t now_ns);
+int display_sched_add_source(display_sched_t *s, uint64_t period_ns, uint64_t phase_ns);
+void display_sched_enable(display_sched_t *s, int source, int enabled);
+void display_sched_set_phase(display_sched_t *s, int source, uint64_t phase_ns);
+void display_sched_set_deadline(display_sched_t *s, uint64_t deadline_ns);
+
+//* Run
+uint64_t display_sched_next(const display_sched_t *s, uint64_t now_ns);
+int display_sched_wait(display_sched_t *s, uint64_t *now_ns);
+
+//* Stats
+void display_sched_report(const display_sched_t *s, FILE *out);
+
+#endif // DISPLAY_SCHED_H
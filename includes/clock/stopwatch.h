@@ -0,0 +1,63 @@
+#ifndef STOPWATCH_H
+#define STOPWATCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Stopwatch / countdown
+ *   Elapsed (or remaining) time is derived from the monotonic time base on
+ *   demand; nothing accumulates per tick. The display shows MM:SS.cc and
+ *   changes every STOPWATCH_TICK_NS, so a running stopwatch is a 100 Hz
+ *   display source whose phase is its start time.
+ */
+
+#define STOPWATCH_TICK_NS     10000000ull   // one centisecond
+#define STOPWATCH_MAX_LAPS    32
+#define STOPWATCH_TEXT_MAX    12            // "MM:SS.cc" plus room for 3-digit minutes
+
+typedef enum {
+    STOPWATCH_UP,       // stopwatch: counts elapsed time from zero
+    STOPWATCH_DOWN      // countdown: counts down from the preset, stops at zero
+} stopwatch_dir_t;
+
+typedef struct {
+    stopwatch_dir_t direction;
+    int running;
+    uint64_t started_ns;        // monotonic time of the last start
+    uint64_t banked_ns;         // elapsed time before the last start
+    uint64_t preset_ns;         // countdown length
+
+    uint64_t laps[STOPWATCH_MAX_LAPS];   // elapsed time at each lap
+    int lap_count;
+
+    // Display accounting while running and shown
+    uint64_t last_frame_ns;     // 0 when the next frame starts a new stretch
+    uint64_t shown_ns;          // time covered by consecutive running frames
+    uint64_t updates;           // those frames that changed the display
+    uint64_t worst_overrun_ns;  // latest wakeup past its deadline
+} stopwatch_t;
+
+//* Control
+void stopwatch_init(stopwatch_t *sw, stopwatch_dir_t direction, uint64_t preset_ns);
+void stopwatch_start(stopwatch_t *sw, uint64_t now_ns);
+void stopwatch_stop(stopwatch_t *sw, uint64_t now_ns);
+int stopwatch_lap(stopwatch_t *sw, uint64_t now_ns);
+void stopwatch_reset(stopwatch_t *sw);
+
+//* Query
+uint64_t stopwatch_elapsed(const stopwatch_t *sw, uint64_t now_ns);
+uint64_t stopwatch_display_ns(const stopwatch_t *sw, uint64_t now_ns);
+int stopwatch_finished(const stopwatch_t *sw, uint64_t now_ns);
+uint64_t stopwatch_phase(const stopwatch_t *sw);
+
+//* Render
+void stopwatch_words(uint64_t value_ns, uint32_t *hex3_hex0, uint32_t *hex5_hex4);
+void stopwatch_format(uint64_t value_ns, char text[STOPWATCH_TEXT_MAX]);
+
+//* Stats
+void stopwatch_account(stopwatch_t *sw, uint64_t deadline_ns, uint64_t now_ns, int changed);
+void stopwatch_account_break(stopwatch_t *sw);
+void stopwatch_report(const stopwatch_t *sw, const char *name, FILE *out);
+
+#endif // STOPWATCH_H
@@ -0,0 +1,16 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+#define NS_PER_MS    1000000ull
+#define NS_PER_SEC   1000000000ull
+
+//* Monotonic time
+uint64_t timebase_now_ns(void);
+int timebase_sleep_until(uint64_t deadline_ns);
+
+//* Accounting
+uint64_t timebase_cpu_ns(void);
+
+#endif // TIMEBASE_H
@@ -0,0 +1,42 @@
+#ifndef WORLD_CLOCK_H
+#define WORLD_CLOCK_H
+
+#include <stdint.h>
+
+/*
+ * World clock
+ *   Every zone is the one monotonic clock tick plus a fixed offset. Each
+ *   zone keeps its own time of day and its two HEX register words, and all
+ *   zones are advanced together on every tick, re-rendering only the digit
+ *   pairs that rolled over. Showing another zone is therefore just storing
+ *   its cached words; no time arithmetic or encoding happens on a switch.
+ */
+
+#define WORLD_CLOCK_MAX_ZONES     16        // selected by SW3..SW0
+#define WORLD_CLOCK_DAY           86400
+#define WORLD_CLOCK_MIN_OFFSET    (-12 * 3600)
+#define WORLD_CLOCK_MAX_OFFSET    (14 * 3600)
+
+typedef struct {
+    int32_t offset_s;           // added to local time; whole minutes
+    int32_t seconds_of_day;     // cached time of day in this zone
+    uint32_t words[2];          // cached HEX3_HEX0, HEX5_HEX4
+} world_zone_t;
+
+typedef struct {
+    world_zone_t zones[WORLD_CLOCK_MAX_ZONES];   // zone 0 is local time
+    int count;
+    int show_seconds;           // 0 blanks HEX1..HEX0 (HH:MM mode)
+    uint64_t tick;              // last tick rendered
+} world_clock_t;
+
+//* Setup
+void world_clock_init(world_clock_t *wc, uint64_t tick, int show_seconds);
+int world_clock_add_zone(world_clock_t *wc, int32_t offset_s);
+int world_clock_parse_offset(const char *text, int32_t *offset_s);
+
+//* Drive
+void world_clock_advance(world_clock_t *wc, uint64_t tick);
+const uint32_t *world_clock_words(const world_clock_t *wc, int zone);
+
+#endif // WORLD_CLOCK_H
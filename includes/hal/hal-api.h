@@ -2,6 +2,7 @@
 #define HAL_API_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 typedef struct {
     int fd;
@@ -13,4 +14,47 @@ int hal_open(hal_map_t *map);
 int hal_close(hal_map_t *map);
 void* hal_get_virtual_addr(hal_map_t *map, unsigned int offset);
 
+//* Shared LW bridge window (reference counted across drivers)
+extern void *hal_lw_base;
+int hal_lw_acquire(void);
+int hal_lw_release(void);
+
+#ifdef HAL_SIM
+#include "hal-sim.h"
+#endif
+#ifdef HAL_TRACE
+#include "hal-trace.h"
+#endif
+
+/*
+ * hal_read32 / hal_write32
+ * Purpose: Single 32-bit MMIO access to a register returned by
+ *          hal_get_virtual_addr. All driver bus traffic goes through here.
+ * Notes:
+ *   Plain volatile load/store in the default build. -DHAL_SIM routes the
+ *   access through the simulated register file; -DHAL_TRACE logs it.
+ */
+
+static inline uint32_t hal_read32(const volatile uint32_t *reg) {
+#ifdef HAL_SIM
+    hal_sim_before_read(reg);
+#endif
+    uint32_t value = *reg;
+#ifdef HAL_TRACE
+    hal_trace_record(HAL_TRACE_READ, reg, value);
+#endif
+    return value;
+}
+
+static inline void hal_write32(volatile uint32_t *reg, uint32_t value) {
+#ifdef HAL_SIM
+    hal_sim_write(reg, value);
+#else
+    *reg = value;
+#endif
+#ifdef HAL_TRACE
+    hal_trace_record(HAL_TRACE_WRITE, reg, value);
+#endif
+}
+
 #endif // HAL_API_H
@@ -0,0 +1,36 @@
+#ifndef HAL_REGS_H
+#define HAL_REGS_H
+
+#include <stdint.h>
+#include "../../lib/address_map_arm.h"
+#include "hal-api.h"
+
+/*
+ * Compile-time register layer
+ *   Register addresses are the shared LW bridge base plus a constant offset
+ *   from address_map_arm.h, and HEX digit word/shift are computed from the
+ *   digit index, so inline accessors called with constant arguments reduce
+ *   to a single load or store. Handle and range checks are HAL_ASSERTs:
+ *   active only in -DHAL_DEBUG builds (`make debug`).
+ */
+
+#ifdef HAL_DEBUG
+#include <assert.h>
+#define HAL_ASSERT(cond)   assert(cond)
+#else
+#define HAL_ASSERT(cond)   ((void)0)
+#endif
+
+// Driver *_inline accessors pass their register's constant offset here and
+// check the handle with HAL_ASSERT only, so each compiles to a single access.
+#define HAL_LW_REG(offset)     ((volatile uint32_t *)((char *)hal_lw_base + (offset)))
+
+// KEY edge-capture register (bit set on press, write 1 to clear)
+#define KEY_EDGE_BASE          (KEY_BASE + 0x0C)
+
+// HEX0..HEX3 share one word, HEX4..HEX5 the next; one byte per digit.
+#define HEX_DIGIT_WORD(d)      ((d) >> 2)
+#define HEX_DIGIT_SHIFT(d)     (((d) & 3) * 8)
+#define HEX_WORD_OFFSET(w)     ((w) ? HEX5_HEX4_BASE : HEX3_HEX0_BASE)
+
+#endif // HAL_REGS_H
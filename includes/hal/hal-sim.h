@@ -0,0 +1,23 @@
+#ifndef HAL_SIM_H
+#define HAL_SIM_H
+
+#include <stdint.h>
+
+/*
+ * Simulated register file
+ *   Built with -DHAL_SIM, hal_open maps a process-local copy of the LW bridge
+ *   window instead of /dev/mem, so the drivers run unchanged on a host.
+ *
+ *   HAL_REPLAY=<trace> feeds the switch and KEY values recorded in a register
+ *   trace back into the simulated registers at the same relative times, each
+ *   change placed between the recorded read that saw it and the one before,
+ *   so replaying a trace through the same binary reproduces it. The process
+ *   receives SIGTERM on the first register access after the recorded run
+ *   length has elapsed.
+ */
+
+void *hal_sim_base(void);
+void hal_sim_before_read(const volatile uint32_t *reg);
+void hal_sim_write(volatile uint32_t *reg, uint32_t value);
+
+#endif // HAL_SIM_H
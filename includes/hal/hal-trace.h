@@ -0,0 +1,51 @@
+#ifndef HAL_TRACE_H
+#define HAL_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Register trace
+ *   Built with -DHAL_TRACE, every hal_read32/hal_write32 is appended to a
+ *   preallocated ring as a 16-byte record and streamed to disk by a
+ *   background writer thread. The file is a hal_trace_header_t followed by
+ *   packed hal_trace_record_t entries (host byte order).
+ *
+ *   HAL_TRACE_FILE selects the output path (default "hal-trace.trc").
+ */
+
+#define HAL_TRACE_MAGIC          "HTRC"
+#define HAL_TRACE_VERSION        1
+#define HAL_TRACE_RING_RECORDS   8192   // must be a power of two
+#define HAL_TRACE_FLUSH_MS       20
+#define HAL_TRACE_DEFAULT_FILE   "hal-trace.trc"
+
+#define HAL_TRACE_READ           0
+#define HAL_TRACE_WRITE          1
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t lw_bridge_span;
+    uint32_t reserved;
+} hal_trace_header_t;
+
+typedef struct {
+    uint64_t timestamp_ns;   // CLOCK_MONOTONIC
+    uint32_t value;
+    uint16_t offset;         // byte offset within the LW bridge window
+    uint8_t op;              // HAL_TRACE_READ / HAL_TRACE_WRITE
+    uint8_t reserved;
+} hal_trace_record_t;
+
+//* Recording (producer side, called from the HAL)
+int hal_trace_attach(const void *virtual_base, unsigned int span);
+void hal_trace_detach(const void *virtual_base);
+void hal_trace_record(int op, const volatile uint32_t *reg, uint32_t value);
+void hal_trace_stop(void);
+
+//* Loading (replay and tooling)
+int hal_trace_load(const char *path, hal_trace_record_t **records, size_t *count);
+
+#endif // HAL_TRACE_H
@@ -1,6 +1,13 @@
 #ifndef HEX_DISPLAY_H
 #define HEX_DISPLAY_H
 
+#include <stdint.h>
+#include "../hal/hal-regs.h"
+
+#define HEX_DISPLAY_COUNT   6
+#define HEX_BLANK           0x10   // logical "digit" with all segments off
+#define HEX_DIGIT_CODES     17     // 0-F plus HEX_BLANK
+
 //* Init & Close
 int init_hex0_hex3(void);
 int init_hex4_hex5(void);
@@ -12,4 +19,83 @@ int hex_display_write(int display, int value);
 int hex_display_clear(int display);
 void hex_display_clear_all(void);
 
-#endif // HEX_DISPLAY_H
\ No newline at end of file
+//* Encode
+int hex_display_glyph(char c);
+void hex_display_render_text(const char *text, uint32_t *hex3_hex0, uint32_t *hex5_hex4);
+
+//* Inline accessors (no runtime validation outside -DHAL_DEBUG builds)
+extern const uint8_t hex_display_seg_table[HEX_DIGIT_CODES];
+extern uint32_t hex_display_shadow[2];
+
+/*
+ * hex_display_write_inline
+ * Purpose: Write one digit; with a constant display index the word and
+ *          shift fold away and this is one shadow update plus one store.
+ * Preconditions: init_hex0_hex3/init_hex4_hex5 succeeded; display 0-5;
+ *                value 0-15 or HEX_BLANK.
+ */
+
+static inline void hex_display_write_inline(int display, int value) {
+    HAL_ASSERT(hal_lw_base != NULL);
+    HAL_ASSERT(display >= 0 && display <= 5);
+    HAL_ASSERT(value >= 0 && value <= HEX_BLANK);
+
+    const int word = HEX_DIGIT_WORD(display);
+    const unsigned int shift = HEX_DIGIT_SHIFT(display);
+    uint32_t next = (hex_display_shadow[word] & ~(0xFFu << shift)) |
+                    ((uint32_t)hex_display_seg_table[value] << shift);
+
+    hex_display_shadow[word] = next;
+    hal_write32(HAL_LW_REG(HEX_WORD_OFFSET(word)), next);
+}
+
+/*
+ * hex_display_encode_pair_inline
+ * Purpose: Segment bytes for a two-digit decimal value, tens in bits 15:8,
+ *          ready to be shifted into a register word (HH, MM, SS, cc fields).
+ * Preconditions: value 0-99.
+ */
+
+static inline uint32_t hex_display_encode_pair_inline(int value) {
+    HAL_ASSERT(value >= 0 && value <= 99);
+    return ((uint32_t)hex_display_seg_table[value / 10] << 8) | hex_display_seg_table[value % 10];
+}
+
+/*
+ * hex_display_write_words_inline
+ * Purpose: Store both HEX words, skipping any equal to the shadow.
+ * Returns: Number of register writes issued (0-2).
+ * Preconditions: init_hex0_hex3/init_hex4_hex5 succeeded.
+ */
+
+static inline int hex_display_write_words_inline(uint32_t hex3_hex0, uint32_t hex5_hex4) {
+    HAL_ASSERT(hal_lw_base != NULL);
+
+    int writes = 0;
+    if (hex3_hex0 != hex_display_shadow[0]) {
+        hex_display_shadow[0] = hex3_hex0;
+        hal_write32(HAL_LW_REG(HEX3_HEX0_BASE), hex3_hex0);
+        writes++;
+    }
+    if (hex5_hex4 != hex_display_shadow[1]) {
+        hex_display_shadow[1] = hex5_hex4;
+        hal_write32(HAL_LW_REG(HEX5_HEX4_BASE), hex5_hex4);
+        writes++;
+    }
+    return writes;
+}
+
+/*
+ * hex_display_pack_window
+ * Purpose: Pack six segment bytes, leftmost (HEX5) first, into the two
+ *          register words. Pure shifts; no table lookups.
+ */
+
+static inline void hex_display_pack_window(const uint8_t window[HEX_DISPLAY_COUNT],
+                                           uint32_t *hex3_hex0, uint32_t *hex5_hex4) {
+    *hex5_hex4 = ((uint32_t)window[0] << 8) | window[1];
+    *hex3_hex0 = ((uint32_t)window[2] << 24) | ((uint32_t)window[3] << 16) |
+                 ((uint32_t)window[4] << 8) | window[5];
+}
+
+#endif // HEX_DISPLAY_H
@@ -0,0 +1,26 @@
+#ifndef HEX_MARQUEE_H
+#define HEX_MARQUEE_H
+
+#include <stdint.h>
+#include "hex-display.h"
+
+/*
+ * HEX marquee
+ *   A message is rendered once into a contiguous strip of segment bytes
+ *   (blank lead-in and lead-out of one display width). Each frame is a
+ *   six-byte window over the strip packed into the two HEX register words,
+ *   so scrolling costs no glyph lookups per frame.
+ */
+
+#define HEX_MARQUEE_MAX_TEXT   64
+#define HEX_MARQUEE_STRIP      (HEX_MARQUEE_MAX_TEXT + 2 * HEX_DISPLAY_COUNT)
+
+typedef struct {
+    uint8_t strip[HEX_MARQUEE_STRIP];
+    int steps;          // number of distinct window positions
+} hex_marquee_t;
+
+int hex_marquee_init(hex_marquee_t *m, const char *text);
+void hex_marquee_frame(const hex_marquee_t *m, int step, uint32_t *hex3_hex0, uint32_t *hex5_hex4);
+
+#endif // HEX_MARQUEE_H
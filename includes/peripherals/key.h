@@ -0,0 +1,35 @@
+#ifndef KEY_H
+#define KEY_H
+
+#include <stdint.h>
+#include "../hal/hal-regs.h"
+
+// DE10 Standard has 4 pushbuttons (KEY0-KEY3)
+#define KEY_COUNT 4
+
+// Key masks
+#define KEY_ALL_MASK 0xF
+
+// Key handle structure
+typedef struct {
+    void *reg_addr;
+    int initialized;
+} key_handle_t;
+
+// Function declarations
+int key_init(key_handle_t *key);
+int key_cleanup(key_handle_t *key);
+int key_read_all(key_handle_t *key, uint32_t *key_state);
+int key_read_presses(key_handle_t *key, uint32_t *presses);
+
+// Inline accessor: returns and clears the latched presses. One read, plus
+// one write only when something was pressed.
+static inline uint32_t key_read_presses_inline(const key_handle_t *key) {
+    HAL_ASSERT(key && key->initialized);
+    (void)key;
+    uint32_t presses = hal_read32(HAL_LW_REG(KEY_EDGE_BASE)) & KEY_ALL_MASK;
+    if (presses) hal_write32(HAL_LW_REG(KEY_EDGE_BASE), presses);
+    return presses;
+}
+
+#endif // KEY_H
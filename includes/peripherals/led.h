@@ -2,6 +2,7 @@
 #define LED_H
 
 #include <stdint.h>
+#include "../hal/hal-regs.h"
 
 typedef struct {
     void *reg_addr;   
@@ -18,6 +19,17 @@ int led_turn_on(led_handle_t *led, int led_number);
 #define LED_ALL_ON      0x3FF  /* All 10 LEDs on: 1111111111 binary */
 #define LED_ALL_OFF     0x000  /* All LEDs off */
 
-#endif // LED_H
+/* Inline accessors: set / read the whole LED bank. */
+static inline void led_set_inline(const led_handle_t *led, uint32_t pattern) {
+    HAL_ASSERT(led && led->initialized);
+    (void)led;
+    hal_write32(HAL_LW_REG(LEDR_BASE), pattern & LED_ALL_ON);
+}
 
+static inline uint32_t led_get_inline(const led_handle_t *led) {
+    HAL_ASSERT(led && led->initialized);
+    (void)led;
+    return hal_read32(HAL_LW_REG(LEDR_BASE)) & LED_ALL_ON;
+}
 
+#endif // LED_H
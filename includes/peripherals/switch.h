@@ -2,6 +2,7 @@
 #define SWITCH_H
 
 #include <stdint.h>
+#include "../hal/hal-regs.h"
 
 // DE10 Standard has 10 switches (SW0-SW9)
 #define SWITCH_COUNT 10
@@ -21,4 +22,11 @@ int switch_cleanup(switch_handle_t *sw);
 int switch_read_all(switch_handle_t *sw, uint32_t *switch_state);
 int switch_read(switch_handle_t *sw, int switch_number, int *state);
 
+// Inline accessor: current position of all switches.
+static inline uint32_t switch_read_all_inline(const switch_handle_t *sw) {
+    HAL_ASSERT(sw && sw->initialized);
+    (void)sw;
+    return hal_read32(HAL_LW_REG(SW_BASE)) & SWITCH_ALL_MASK;
+}
+
 #endif // SWITCH_H
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include <stddef.h>
+#include "../../includes/clock/alarm.h"
+
+//?------------------------------------------------------------------------
+//?     CONSTANTS
+//?------------------------------------------------------------------------
+#define SLOT_MASK        (ALARM_WHEEL_SLOTS - 1)
+#define INDEX_MASK       0xFFFFu
+#define LEVEL_SHIFT(l)   ((l) * ALARM_WHEEL_BITS)
+
+static inline alarm_id_t make_id(const alarm_t *a, int32_t index) {
+    return ((alarm_id_t)a->generation << 16) | (alarm_id_t)index;
+}
+
+static inline uint64_t rotate_right(uint64_t bits, unsigned int n) {
+    n &= 63;
+    return n ? (bits >> n) | (bits << (64 - n)) : bits;
+}
+
+//?------------------------------------------------------------------------
+//?     BUCKETS
+//?------------------------------------------------------------------------
+
+/*
+ * link_alarm
+ * Purpose: Put an alarm into the bucket that matches its distance from now.
+ * Returns: 0 on success; -1 if it is further out than ALARM_MAX_DELAY.
+ * Notes:
+ *   Slots are chosen from the absolute expiry bits, so an alarm at level L
+ *   is cascaded exactly when the level-L index reaches its slot.
+ */
+
+static int link_alarm(alarm_wheel_t *w, int32_t index) {
+    alarm_t *a = &w->pool[index];
+    uint64_t delta = a->expires - w->now;
+
+    int level = 0;
+    while (level < ALARM_WHEEL_LEVELS && delta >= (1ull << LEVEL_SHIFT(level + 1))) level++;
+    if (level == ALARM_WHEEL_LEVELS) return -1;
+
+    int slot = (int)((a->expires >> LEVEL_SHIFT(level)) & SLOT_MASK);
+    int bucket = level * ALARM_WHEEL_SLOTS + slot;
+
+    a->bucket = (int16_t)bucket;
+    a->prev = -1;
+    a->next = w->heads[bucket];
+    if (a->next >= 0) w->pool[a->next].prev = index;
+    w->heads[bucket] = index;
+    w->occupied[level] |= 1ull << slot;
+    return 0;
+}
+
+static void unlink_alarm(alarm_wheel_t *w, int32_t index) {
+    alarm_t *a = &w->pool[index];
+    int bucket = a->bucket;
+
+    if (a->prev >= 0) w->pool[a->prev].next = a->next;
+    else w->heads[bucket] = a->next;
+    if (a->next >= 0) w->pool[a->next].prev = a->prev;
+
+    if (w->heads[bucket] < 0) {
+        w->occupied[bucket / ALARM_WHEEL_SLOTS] &= ~(1ull << (bucket & SLOT_MASK));
+    }
+    a->bucket = -1;
+}
+
+static void release_alarm(alarm_wheel_t *w, int32_t index) {
+    alarm_t *a = &w->pool[index];
+    a->generation++;
+    if (a->generation == 0) a->generation = 1;   // keep ids nonzero
+    a->next = w->free_head;
+    w->free_head = index;
+    w->active--;
+}
+
+//?------------------------------------------------------------------------
+//?     SETUP
+//?------------------------------------------------------------------------
+
+/*
+ * alarm_wheel_init
+ * Purpose: Empty the wheel and set its current tick.
+ * Params:
+ *   w        - wheel to initialize.
+ *   now_tick - current clock tick.
+ *   on_fire  - expiry handler (may be NULL).
+ *   ctx      - passed to on_fire.
+ * Returns: void
+ */
+
+void alarm_wheel_init(alarm_wheel_t *w, uint64_t now_tick, alarm_fire_fn on_fire, void *ctx) {
+    w->now = now_tick;
+    for (int i = 0; i < ALARM_WHEEL_LEVELS * ALARM_WHEEL_SLOTS; i++) w->heads[i] = -1;
+    for (int l = 0; l < ALARM_WHEEL_LEVELS; l++) w->occupied[l] = 0;
+
+    for (int32_t i = 0; i < ALARM_MAX; i++) {
+        w->pool[i].bucket = -1;
+        w->pool[i].generation = 1;
+        w->pool[i].next = i + 1 < ALARM_MAX ? i + 1 : -1;
+    }
+    w->free_head = 0;
+    w->active = 0;
+    w->on_fire = on_fire;
+    w->ctx = ctx;
+}
+
+//?------------------------------------------------------------------------
+//?     INSERT & CANCEL
+//?------------------------------------------------------------------------
+
+/*
+ * alarm_add
+ * Purpose: Schedule an alarm.
+ * Params:
+ *   w            - wheel.
+ *   expires_tick - tick at which it fires; past ticks fire on the next tick.
+ *   spec         - action description (copied).
+ * Returns:
+ *   Alarm id on success; ALARM_ID_NONE if the pool is full or the expiry is
+ *   more than ALARM_MAX_DELAY ticks away.
+ */
+
+alarm_id_t alarm_add(alarm_wheel_t *w, uint64_t expires_tick, const alarm_spec_t *spec) {
+    if (!spec || w->free_head < 0) return ALARM_ID_NONE;
+
+    int32_t index = w->free_head;
+    alarm_t *a = &w->pool[index];
+
+    a->expires = expires_tick > w->now ? expires_tick : w->now + 1;
+    a->spec = *spec;
+    w->free_head = a->next;
+    w->active++;
+
+    if (link_alarm(w, index) != 0) {
+        release_alarm(w, index);
+        return ALARM_ID_NONE;
+    }
+    return make_id(a, index);
+}
+
+/*
+ * alarm_cancel
+ * Purpose: Remove a pending alarm.
+ * Params:  id - value returned by alarm_add.
+ * Returns: 0 on success; -1 if the id is stale (fired or already cancelled).
+ */
+
+int alarm_cancel(alarm_wheel_t *w, alarm_id_t id) {
+    int32_t index = (int32_t)(id & INDEX_MASK);
+    if (index >= ALARM_MAX) return -1;
+
+    alarm_t *a = &w->pool[index];
+    if (a->bucket < 0 || make_id(a, index) != id) return -1;
+
+    unlink_alarm(w, index);
+    release_alarm(w, index);
+    return 0;
+}
+
+//?------------------------------------------------------------------------
+//?     DRIVE
+//?------------------------------------------------------------------------
+
+static void cascade(alarm_wheel_t *w, int level, int slot) {
+    int bucket = level * ALARM_WHEEL_SLOTS + slot;
+    int32_t index;
+    while ((index = w->heads[bucket]) >= 0) {
+        unlink_alarm(w, index);
+        link_alarm(w, index);   // now closer, lands on a lower level
+    }
+}
+
+/*
+ * alarm_wheel_tick
+ * Purpose: Advance one tick and fire every alarm due at the new tick.
+ * Returns: void
+ * Notes:
+ *   Periodic alarms are re-armed before their handler runs, so the handler
+ *   may cancel them by id.
+ */
+
+void alarm_wheel_tick(alarm_wheel_t *w) {
+    w->now++;
+
+    for (int level = 1; level < ALARM_WHEEL_LEVELS; level++) {
+        if (w->now & ((1ull << LEVEL_SHIFT(level)) - 1)) break;
+        cascade(w, level, (int)((w->now >> LEVEL_SHIFT(level)) & SLOT_MASK));
+    }
+
+    int bucket = (int)(w->now & SLOT_MASK);
+    int32_t index;
+    while ((index = w->heads[bucket]) >= 0) {
+        alarm_t *a = &w->pool[index];
+        alarm_id_t id = make_id(a, index);
+        alarm_spec_t spec = a->spec;
+
+        unlink_alarm(w, index);
+        if (spec.period) {
+            a->expires += spec.period;
+            if (link_alarm(w, index) != 0) release_alarm(w, index);
+        } else {
+            release_alarm(w, index);
+        }
+
+        if (w->on_fire) w->on_fire(w->ctx, id, &spec);
+    }
+}
+
+/*
+ * alarm_wheel_next
+ * Purpose: Earliest tick at which alarm_wheel_tick has work (a firing or a
+ *          non-empty cascade).
+ * Returns: Tick number, or ALARM_NEVER if the wheel is empty.
+ */
+
+uint64_t alarm_wheel_next(const alarm_wheel_t *w) {
+    uint64_t next = ALARM_NEVER;
+
+    if (w->occupied[0]) {
+        uint64_t first = w->now + 1;
+        uint64_t bits = rotate_right(w->occupied[0], (unsigned int)(first & SLOT_MASK));
+        next = first + (uint64_t)__builtin_ctzll(bits);
+    }
+
+    for (int level = 1; level < ALARM_WHEEL_LEVELS; level++) {
+        if (!w->occupied[level]) continue;
+
+        unsigned int shift = LEVEL_SHIFT(level);
+        uint64_t base = ((w->now >> shift) + 1) << shift;
+        uint64_t bits = rotate_right(w->occupied[level], (unsigned int)((base >> shift) & SLOT_MASK));
+        uint64_t at = base + ((uint64_t)__builtin_ctzll(bits) << shift);
+        if (at < next) next = at;
+    }
+    return next;
+}
+
+/*
+ * alarm_wheel_advance
+ * Purpose: Catch the wheel up to target_tick (e.g. after a tickless sleep).
+ * Params:  target_tick - current clock tick.
+ * Returns: void
+ * Notes:   Empty stretches are skipped in one step using alarm_wheel_next.
+ */
+
+void alarm_wheel_advance(alarm_wheel_t *w, uint64_t target_tick) {
+    while (w->now < target_tick) {
+        uint64_t next = alarm_wheel_next(w);
+        if (next > target_tick) {
+            w->now = target_tick;
+            break;
+        }
+        w->now = next - 1;
+        alarm_wheel_tick(w);
+    }
+}
@@ -0,0 +1,215 @@
+#include "../../includes/clock/display-sched.h"
+#include "../../includes/clock/timebase.h"
+
+//?------------------------------------------------------------------------
+//?     SETUP
+//?------------------------------------------------------------------------
+
+/*
+ * display_sched_init
+ * Purpose: Reset a scheduler to no sources and start its accounting window.
+ * Params:
+ *   s      - scheduler to initialize.
+ *   now_ns - current monotonic time.
+ * Returns: void
+ */
+
+void display_sched_init(display_sched_t *s, uint64_t now_ns) {
+    s->source_count = 0;
+    s->deadline_ns = DISPLAY_SCHED_NEVER;
+    s->woke_for_ns = now_ns;
+
+    s->start_ns = now_ns;
+    s->start_cpu_ns = timebase_cpu_ns();
+    s->total_wakeups = 0;
+    s->window_start_ns = now_ns;
+    s->window_cpu_ns = s->start_cpu_ns;
+    s->window_wakeups = 0;
+}
+
+/*
+ * display_sched_add_source
+ * Purpose: Register a periodic output change (enabled on creation).
+ * Params:
+ *   s         - scheduler.
+ *   period_ns - time between changes; must be nonzero.
+ *   phase_ns  - any monotonic time at which a change happens.
+ * Returns:
+ *   Source id (>= 0) on success; -1 if full or period is zero.
+ */
+
+int display_sched_add_source(display_sched_t *s, uint64_t period_ns, uint64_t phase_ns) {
+    if (period_ns == 0 || s->source_count >= DISPLAY_SCHED_MAX_SOURCES) return -1;
+
+    display_source_t *src = &s->sources[s->source_count];
+    src->period_ns = period_ns;
+    src->phase_ns = phase_ns % period_ns;
+    src->enabled = 1;
+    return s->source_count++;
+}
+
+/*
+ * display_sched_enable
+ * Purpose: Turn a source's wakeups on or off (phase and period are kept).
+ * Params:
+ *   source  - id returned by display_sched_add_source; others are ignored.
+ *   enabled - nonzero to wake on its boundaries.
+ * Returns: void
+ */
+
+void display_sched_enable(display_sched_t *s, int source, int enabled) {
+    if (source < 0 || source >= s->source_count) return;
+    s->sources[source].enabled = enabled;
+}
+
+/*
+ * display_sched_set_phase
+ * Purpose: Re-align a source (e.g. a stopwatch restarted at an arbitrary time).
+ * Params:
+ *   source   - id returned by display_sched_add_source.
+ *   phase_ns - any monotonic time at which a change happens.
+ * Returns: void
+ */
+
+void display_sched_set_phase(display_sched_t *s, int source, uint64_t phase_ns) {
+    if (source < 0 || source >= s->source_count) return;
+    s->sources[source].phase_ns = phase_ns % s->sources[source].period_ns;
+}
+
+/*
+ * display_sched_set_deadline
+ * Purpose: Request a one-shot wake (e.g. an alarm); cleared when reached.
+ * Params:
+ *   deadline_ns - absolute monotonic time, or DISPLAY_SCHED_NEVER to clear.
+ * Returns: void
+ */
+
+void display_sched_set_deadline(display_sched_t *s, uint64_t deadline_ns) {
+    s->deadline_ns = deadline_ns;
+}
+
+//?------------------------------------------------------------------------
+//?     RUN
+//?------------------------------------------------------------------------
+
+// First boundary of a source strictly after after_ns.
+static uint64_t source_next(const display_source_t *src, uint64_t after_ns) {
+    uint64_t since = (after_ns + src->period_ns - src->phase_ns) % src->period_ns;
+    return after_ns + (src->period_ns - since);
+}
+
+/*
+ * display_sched_next
+ * Purpose: Earliest time after now_ns at which the output can change.
+ * Returns: Absolute monotonic time, or DISPLAY_SCHED_NEVER.
+ */
+
+uint64_t display_sched_next(const display_sched_t *s, uint64_t now_ns) {
+    uint64_t next = s->deadline_ns;
+
+    for (int i = 0; i < s->source_count; i++) {
+        const display_source_t *src = &s->sources[i];
+        if (!src->enabled) continue;
+
+        uint64_t at = source_next(src, now_ns);
+        if (at < next) next = at;
+    }
+    return next;
+}
+
+/*
+ * catch_up_next
+ * Purpose: Target for the next wait: the earliest boundary after the last
+ *          target, but at most one period back per source.
+ * Notes:
+ *   Counting from the last target means a frame that ran past the next
+ *   boundary still gets that boundary (woken at once). The one-period
+ *   clamp means after a long stall only the latest missed boundary of each
+ *   source is caught up, not every one in between.
+ */
+
+static uint64_t catch_up_next(const display_sched_t *s, uint64_t now_ns) {
+    uint64_t next = s->deadline_ns;
+
+    for (int i = 0; i < s->source_count; i++) {
+        const display_source_t *src = &s->sources[i];
+        if (!src->enabled) continue;
+
+        uint64_t after = s->woke_for_ns;
+        if (now_ns > src->period_ns && after < now_ns - src->period_ns) after = now_ns - src->period_ns;
+        uint64_t at = source_next(src, after);
+        if (at < next) next = at;
+    }
+    return next;
+}
+
+static void account_wakeup(display_sched_t *s, uint64_t now_ns) {
+    s->total_wakeups++;
+    s->window_wakeups++;
+
+    if (now_ns - s->window_start_ns < DISPLAY_SCHED_REPORT_NS) return;
+
+    uint64_t cpu = timebase_cpu_ns();
+    printf("sched: %llu wakeups, %.3f ms CPU in the last hour\n",
+           (unsigned long long)s->window_wakeups, (cpu - s->window_cpu_ns) / 1e6);
+    s->window_start_ns = now_ns;
+    s->window_cpu_ns = cpu;
+    s->window_wakeups = 0;
+}
+
+/*
+ * display_sched_wait
+ * Purpose: Sleep until the next output change and account the wakeup.
+ * Params:
+ *   s      - scheduler.
+ *   now_ns - out parameter; monotonic time after waking.
+ * Returns:
+ *   0 when a change is due; -1 if interrupted by a signal (or nothing is
+ *   scheduled at all).
+ * Notes:
+ *   A reached one-shot deadline is cleared. A boundary missed by a late
+ *   frame or a stall is caught up once (see catch_up_next). The target
+ *   time is kept in woke_for_ns, so *now_ns - woke_for_ns is the wakeup
+ *   overrun (zero after an interrupted wait). The hourly stats line is
+ *   printed from a regular wakeup, never from a wakeup of its own.
+ */
+
+int display_sched_wait(display_sched_t *s, uint64_t *now_ns) {
+    uint64_t next = catch_up_next(s, timebase_now_ns());
+    if (next == DISPLAY_SCHED_NEVER) return -1;
+
+    int rc = timebase_sleep_until(next);
+    *now_ns = timebase_now_ns();
+    if (rc != 0) {
+        s->woke_for_ns = *now_ns;
+        return -1;
+    }
+
+    s->woke_for_ns = next;
+    if (s->deadline_ns <= *now_ns) s->deadline_ns = DISPLAY_SCHED_NEVER;
+    account_wakeup(s, *now_ns);
+    return 0;
+}
+
+//?------------------------------------------------------------------------
+//?     STATS
+//?------------------------------------------------------------------------
+
+/*
+ * display_sched_report
+ * Purpose: Print lifetime wakeup and CPU totals, normalized per hour.
+ * Returns: void
+ */
+
+void display_sched_report(const display_sched_t *s, FILE *out) {
+    uint64_t elapsed = timebase_now_ns() - s->start_ns;
+    double cpu_ms = (timebase_cpu_ns() - s->start_cpu_ns) / 1e6;
+    double hours = elapsed / (double)DISPLAY_SCHED_REPORT_NS;
+
+    fprintf(out, "sched: %llu wakeups, %.3f ms CPU over %.3f h",
+            (unsigned long long)s->total_wakeups, cpu_ms, hours);
+    if (hours > 0.0) {
+        fprintf(out, " (%.1f wakeups/h, %.3f ms CPU/h)", s->total_wakeups / hours, cpu_ms / hours);
+    }
+    fprintf(out, "\n");
+}
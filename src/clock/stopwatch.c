@@ -0,0 +1,233 @@
+#include <string.h>
+#include "../../includes/clock/stopwatch.h"
+#include "../../includes/peripherals/hex-display.h"
+
+//?------------------------------------------------------------------------
+//?     CONTROL
+//?------------------------------------------------------------------------
+
+/*
+ * stopwatch_init
+ * Purpose: Reset a stopwatch or countdown to its stopped initial state.
+ * Params:
+ *   sw        - stopwatch to initialize.
+ *   direction - STOPWATCH_UP or STOPWATCH_DOWN.
+ *   preset_ns - countdown length (ignored for STOPWATCH_UP).
+ * Returns: void
+ */
+
+void stopwatch_init(stopwatch_t *sw, stopwatch_dir_t direction, uint64_t preset_ns) {
+    memset(sw, 0, sizeof(*sw));
+    sw->direction = direction;
+    sw->preset_ns = preset_ns;
+}
+
+/*
+ * stopwatch_start
+ * Purpose: Start or resume counting from now.
+ * Params:
+ *   sw     - stopwatch.
+ *   now_ns - monotonic time of the start.
+ * Returns: void
+ * Notes:   No effect if already running or if a countdown has reached zero.
+ */
+
+void stopwatch_start(stopwatch_t *sw, uint64_t now_ns) {
+    if (sw->running || stopwatch_finished(sw, now_ns)) return;
+    sw->started_ns = now_ns;
+    sw->running = 1;
+}
+
+/*
+ * stopwatch_stop
+ * Purpose: Stop counting, keeping the elapsed time for a later resume.
+ * Params:
+ *   sw     - stopwatch.
+ *   now_ns - monotonic time of the stop.
+ * Returns: void
+ * Notes:   Ends the current display accounting stretch.
+ */
+
+void stopwatch_stop(stopwatch_t *sw, uint64_t now_ns) {
+    if (!sw->running) return;
+    sw->banked_ns = stopwatch_elapsed(sw, now_ns);
+    sw->running = 0;
+    sw->last_frame_ns = 0;
+}
+
+/*
+ * stopwatch_lap
+ * Purpose: Record the current elapsed time as a lap.
+ * Returns: Lap index (0-based) on success; -1 if the lap table is full.
+ */
+
+int stopwatch_lap(stopwatch_t *sw, uint64_t now_ns) {
+    if (sw->lap_count >= STOPWATCH_MAX_LAPS) return -1;
+    sw->laps[sw->lap_count] = stopwatch_elapsed(sw, now_ns);
+    return sw->lap_count++;
+}
+
+/*
+ * stopwatch_reset
+ * Purpose: Stop and return to zero (or the countdown preset); clear laps.
+ * Returns: void
+ * Notes:   Display accounting is kept so it can still be reported.
+ */
+
+void stopwatch_reset(stopwatch_t *sw) {
+    sw->running = 0;
+    sw->last_frame_ns = 0;
+    sw->banked_ns = 0;
+    sw->lap_count = 0;
+}
+
+//?------------------------------------------------------------------------
+//?     QUERY
+//?------------------------------------------------------------------------
+
+/*
+ * stopwatch_elapsed
+ * Purpose: Time counted so far; a countdown saturates at its preset.
+ * Returns: Nanoseconds.
+ */
+
+uint64_t stopwatch_elapsed(const stopwatch_t *sw, uint64_t now_ns) {
+    uint64_t elapsed = sw->banked_ns + (sw->running ? now_ns - sw->started_ns : 0);
+    if (sw->direction == STOPWATCH_DOWN && elapsed > sw->preset_ns) elapsed = sw->preset_ns;
+    return elapsed;
+}
+
+/*
+ * stopwatch_display_ns
+ * Purpose: Value to show: elapsed time, or remaining time for a countdown.
+ * Returns: Nanoseconds.
+ */
+
+uint64_t stopwatch_display_ns(const stopwatch_t *sw, uint64_t now_ns) {
+    uint64_t elapsed = stopwatch_elapsed(sw, now_ns);
+    return sw->direction == STOPWATCH_DOWN ? sw->preset_ns - elapsed : elapsed;
+}
+
+/*
+ * stopwatch_finished
+ * Purpose: Whether a countdown has reached zero.
+ * Returns: 1 if so; 0 otherwise (always 0 for a stopwatch).
+ */
+
+int stopwatch_finished(const stopwatch_t *sw, uint64_t now_ns) {
+    return sw->direction == STOPWATCH_DOWN && stopwatch_elapsed(sw, now_ns) >= sw->preset_ns;
+}
+
+/*
+ * stopwatch_phase
+ * Purpose: A monotonic time at which the shown centisecond changes, for
+ *          aligning a STOPWATCH_TICK_NS display source after a (re)start.
+ * Returns: Nanoseconds (any representative; callers reduce it modulo the tick).
+ */
+
+uint64_t stopwatch_phase(const stopwatch_t *sw) {
+    uint64_t offset = sw->direction == STOPWATCH_DOWN ? sw->preset_ns % STOPWATCH_TICK_NS : 0;
+    return sw->started_ns + STOPWATCH_TICK_NS + offset - sw->banked_ns % STOPWATCH_TICK_NS;
+}
+
+//?------------------------------------------------------------------------
+//?     RENDER
+//?------------------------------------------------------------------------
+
+/*
+ * stopwatch_words
+ * Purpose: Build the HEX words for MM:SS.cc (HEX5..HEX0).
+ * Params:
+ *   value_ns  - time to show; minutes wrap at 100.
+ *   hex3_hex0 - out parameter; SS cc.
+ *   hex5_hex4 - out parameter; MM.
+ * Returns: void
+ * Notes:
+ *   Callers pass both words to hex_display_write_words_inline, which skips
+ *   the minutes word for the 5999 of every 6000 frames where it is unchanged.
+ */
+
+void stopwatch_words(uint64_t value_ns, uint32_t *hex3_hex0, uint32_t *hex5_hex4) {
+    uint64_t cs = value_ns / STOPWATCH_TICK_NS;
+    int centis = (int)(cs % 100);
+    int seconds = (int)((cs / 100) % 60);
+    int minutes = (int)((cs / 6000) % 100);
+
+    *hex3_hex0 = (hex_display_encode_pair_inline(seconds) << 16) | hex_display_encode_pair_inline(centis);
+    *hex5_hex4 = hex_display_encode_pair_inline(minutes);
+}
+
+/*
+ * stopwatch_format
+ * Purpose: Text form of a time for lap and stats output.
+ * Params:
+ *   value_ns - time to format; minutes are not wrapped (up to 999).
+ *   text     - out buffer; receives "MM:SS.cc".
+ * Returns: void
+ */
+
+void stopwatch_format(uint64_t value_ns, char text[STOPWATCH_TEXT_MAX]) {
+    uint64_t cs = value_ns / STOPWATCH_TICK_NS;
+    snprintf(text, STOPWATCH_TEXT_MAX, "%02u:%02u.%02u", (unsigned int)((cs / 6000) % 1000),
+             (unsigned int)((cs / 100) % 60), (unsigned int)(cs % 100));
+}
+
+//?------------------------------------------------------------------------
+//?     STATS
+//?------------------------------------------------------------------------
+
+/*
+ * stopwatch_account
+ * Purpose: Record one frame drawn while running, for the update-rate and
+ *          overrun report.
+ * Params:
+ *   sw          - running stopwatch.
+ *   deadline_ns - the time the wakeup was scheduled for.
+ *   now_ns      - actual wake time.
+ *   changed     - nonzero if the frame changed the display.
+ * Returns: void
+ * Notes:
+ *   Only the time between consecutive frames counts, so periods where the
+ *   stopwatch was stopped or not shown do not dilute the rate.
+ */
+
+void stopwatch_account(stopwatch_t *sw, uint64_t deadline_ns, uint64_t now_ns, int changed) {
+    if (now_ns > deadline_ns && now_ns - deadline_ns > sw->worst_overrun_ns) {
+        sw->worst_overrun_ns = now_ns - deadline_ns;
+    }
+    if (sw->last_frame_ns) {
+        sw->shown_ns += now_ns - sw->last_frame_ns;
+        if (changed) sw->updates++;
+    }
+    sw->last_frame_ns = now_ns;
+}
+
+/*
+ * stopwatch_account_break
+ * Purpose: Note that the display stopped showing this stopwatch, so the
+ *          next accounted frame starts a new stretch.
+ * Returns: void
+ */
+
+void stopwatch_account_break(stopwatch_t *sw) {
+    sw->last_frame_ns = 0;
+}
+
+/*
+ * stopwatch_report
+ * Purpose: Print laps, achieved display update rate and worst overrun.
+ * Returns: void
+ */
+
+void stopwatch_report(const stopwatch_t *sw, const char *name, FILE *out) {
+    char text[STOPWATCH_TEXT_MAX];
+    for (int i = 0; i < sw->lap_count; i++) {
+        stopwatch_format(sw->laps[i], text);
+        fprintf(out, "%s: lap %d %s\n", name, i + 1, text);
+    }
+
+    double seconds = sw->shown_ns / 1e9;
+    fprintf(out, "%s: %llu display updates in %.2f s (%.1f Hz), worst tick overrun %.3f ms\n",
+            name, (unsigned long long)sw->updates, seconds,
+            seconds > 0.0 ? sw->updates / seconds : 0.0, sw->worst_overrun_ns / 1e6);
+}
@@ -0,0 +1,50 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <time.h>
+#include "../../includes/clock/timebase.h"
+
+static uint64_t to_ns(const struct timespec *ts) {
+    return (uint64_t)ts->tv_sec * NS_PER_SEC + (uint64_t)ts->tv_nsec;
+}
+
+/*
+ * timebase_now_ns
+ * Purpose: Current CLOCK_MONOTONIC time.
+ * Returns: Nanoseconds since an arbitrary fixed point (boot).
+ */
+
+uint64_t timebase_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return to_ns(&ts);
+}
+
+/*
+ * timebase_sleep_until
+ * Purpose: Block until an absolute CLOCK_MONOTONIC deadline.
+ * Params:
+ *   deadline_ns - absolute wake time; returns immediately if already past.
+ * Returns:
+ *   0 when the deadline was reached; -1 if interrupted by a signal.
+ * Notes:
+ *   Absolute deadlines do not accumulate drift across wakeups.
+ */
+
+int timebase_sleep_until(uint64_t deadline_ns) {
+    struct timespec ts = { (time_t)(deadline_ns / NS_PER_SEC), (long)(deadline_ns % NS_PER_SEC) };
+    int rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    return rc == 0 ? 0 : (rc == EINTR ? -1 : 0);
+}
+
+/*
+ * timebase_cpu_ns
+ * Purpose: CPU time consumed by this process so far.
+ * Returns: Nanoseconds of CLOCK_PROCESS_CPUTIME_ID.
+ */
+
+uint64_t timebase_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return to_ns(&ts);
+}
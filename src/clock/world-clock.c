@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include "../../includes/clock/world-clock.h"
+#include "../../includes/peripherals/hex-display.h"
+
+//?------------------------------------------------------------------------
+//?     RENDER
+//?------------------------------------------------------------------------
+
+static void render_zone(world_zone_t *z, int show_seconds) {
+    int sod = z->seconds_of_day;
+    z->words[1] = hex_display_encode_pair_inline(sod / 3600);
+    z->words[0] = hex_display_encode_pair_inline((sod / 60) % 60) << 16;
+    if (show_seconds) z->words[0] |= hex_display_encode_pair_inline(sod % 60);
+}
+
+static int32_t zone_time(uint64_t tick, int32_t offset_s) {
+    return (int32_t)((tick % WORLD_CLOCK_DAY + WORLD_CLOCK_DAY + offset_s) % WORLD_CLOCK_DAY);
+}
+
+//?------------------------------------------------------------------------
+//?     SETUP
+//?------------------------------------------------------------------------
+
+/*
+ * world_clock_init
+ * Purpose: Start a world clock with only the local zone (offset 0).
+ * Params:
+ *   wc           - world clock to initialize.
+ *   tick         - current clock tick (seconds; local time of day = tick % day).
+ *   show_seconds - 0 for HH:MM rendering.
+ * Returns: void
+ */
+
+void world_clock_init(world_clock_t *wc, uint64_t tick, int show_seconds) {
+    wc->count = 0;
+    wc->show_seconds = show_seconds;
+    wc->tick = tick;
+    world_clock_add_zone(wc, 0);
+}
+
+/*
+ * world_clock_add_zone
+ * Purpose: Add a zone and render its words for the current tick.
+ * Params:  offset_s - seconds added to local time (whole minutes).
+ * Returns: Zone index on success; -1 if the table is full or the offset is
+ *          out of range.
+ */
+
+int world_clock_add_zone(world_clock_t *wc, int32_t offset_s) {
+    if (wc->count >= WORLD_CLOCK_MAX_ZONES) return -1;
+    if (offset_s < WORLD_CLOCK_MIN_OFFSET || offset_s > WORLD_CLOCK_MAX_OFFSET || offset_s % 60) return -1;
+
+    world_zone_t *z = &wc->zones[wc->count];
+    z->offset_s = offset_s;
+    z->seconds_of_day = zone_time(wc->tick, offset_s);
+    render_zone(z, wc->show_seconds);
+    return wc->count++;
+}
+
+/*
+ * world_clock_parse_offset
+ * Purpose: Parse a UTC-style offset "+HH:MM" / "-HH:MM" relative to local time.
+ * Returns: 0 on success; -1 on malformed or out-of-range input.
+ */
+
+int world_clock_parse_offset(const char *text, int32_t *offset_s) {
+    char sign, extra;
+    int h, m;
+    if (sscanf(text, "%c%d:%d%c", &sign, &h, &m, &extra) != 3) return -1;
+    if ((sign != '+' && sign != '-') || h < 0 || m < 0 || m > 59) return -1;
+
+    int32_t offset = (h * 3600 + m * 60) * (sign == '-' ? -1 : 1);
+    if (offset < WORLD_CLOCK_MIN_OFFSET || offset > WORLD_CLOCK_MAX_OFFSET) return -1;
+    *offset_s = offset;
+    return 0;
+}
+
+//?------------------------------------------------------------------------
+//?     DRIVE
+//?------------------------------------------------------------------------
+
+/*
+ * world_clock_advance
+ * Purpose: Bring every zone's cached time and words up to tick.
+ * Params:  tick - current clock tick; never behind the last one.
+ * Returns: void
+ * Notes:
+ *   Offsets are whole minutes, so all zones roll over minutes together:
+ *   within a minute only the seconds pair of each zone is re-encoded
+ *   (nothing at all in HH:MM mode).
+ */
+
+void world_clock_advance(world_clock_t *wc, uint64_t tick) {
+    if (tick <= wc->tick) return;
+    uint64_t delta = tick - wc->tick;
+    wc->tick = tick;
+
+    for (int i = 0; i < wc->count; i++) {
+        world_zone_t *z = &wc->zones[i];
+        int32_t prev = z->seconds_of_day;
+        z->seconds_of_day = (int32_t)((prev + delta % WORLD_CLOCK_DAY) % WORLD_CLOCK_DAY);
+
+        if (delta < 60 && z->seconds_of_day / 60 == prev / 60) {
+            if (wc->show_seconds) {
+                z->words[0] = (z->words[0] & 0xFFFF0000u) | hex_display_encode_pair_inline(z->seconds_of_day % 60);
+            }
+        } else {
+            render_zone(z, wc->show_seconds);
+        }
+    }
+}
+
+/*
+ * world_clock_words
+ * Purpose: Cached register words of a zone.
+ * Params:  zone - index; unconfigured indices fall back to zone 0 (local).
+ * Returns: Pointer to { HEX3_HEX0, HEX5_HEX4 }.
+ */
+
+const uint32_t *world_clock_words(const world_clock_t *wc, int zone) {
+    if (zone < 0 || zone >= wc->count) zone = 0;
+    return wc->zones[zone].words;
+}
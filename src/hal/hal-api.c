@@ -18,12 +18,19 @@
  *   map != NULL.
  * Errors:
  *   Fails if /dev/mem open or mmap fails.
+ * Notes:
+ *   -DHAL_SIM maps the simulated register file instead; -DHAL_TRACE
+ *   registers the window with the register trace.
  */
 
 
 int hal_open(hal_map_t *map) {
     if (!map) return -1;
 
+#ifdef HAL_SIM
+    map->fd = -1;
+    map->virtual_base = hal_sim_base();
+#else
     map->fd = open("/dev/mem", O_RDWR | O_SYNC);
     if (map->fd == -1) {
         perror("ERROR: could not open /dev/mem");
@@ -37,8 +44,12 @@ int hal_open(hal_map_t *map) {
         close(map->fd);
         return -1;
     }
+#endif
 
     map->span = LW_BRIDGE_SPAN;
+#ifdef HAL_TRACE
+    hal_trace_attach(map->virtual_base, map->span);
+#endif
     return 0;
 }
 
@@ -59,12 +70,17 @@ int hal_open(hal_map_t *map) {
 int hal_close(hal_map_t *map) {
     if (!map) return -1;
 
+#ifdef HAL_TRACE
+    hal_trace_detach(map->virtual_base);
+#endif
+#ifndef HAL_SIM
     if (munmap(map->virtual_base, map->span) != 0) {
         perror("ERROR: munmap() failed");
         return -1;
     }
 
     close(map->fd);
+#endif
     map->fd = -1;
     map->virtual_base = NULL;
     map->span = 0;
@@ -88,4 +104,46 @@ void* hal_get_virtual_addr(hal_map_t *map, unsigned int offset) {
     if (!map || !map->virtual_base) return NULL;
     
     return (void*)((char*)map->virtual_base + offset);
-}
\ No newline at end of file
+}
+
+//?------------------------------------------------------------------------
+//?     SHARED LW BRIDGE WINDOW
+//?------------------------------------------------------------------------
+void *hal_lw_base = NULL;
+
+static hal_map_t lw_map;
+static int lw_users = 0;
+
+/*
+ * hal_lw_acquire
+ * Purpose: Take a reference on the process-wide LW bridge mapping, opening
+ *          it on first use.
+ * Returns:
+ *   0 on success (hal_lw_base is valid); -1 if hal_open fails.
+ * Notes:
+ *   One mapping serves every driver, so a register address is hal_lw_base
+ *   plus a compile-time offset from address_map_arm.h (see hal-regs.h).
+ */
+
+int hal_lw_acquire(void) {
+    if (lw_users == 0) {
+        if (hal_open(&lw_map) != 0) return -1;
+        hal_lw_base = lw_map.virtual_base;
+    }
+    lw_users++;
+    return 0;
+}
+
+/*
+ * hal_lw_release
+ * Purpose: Drop a reference taken by hal_lw_acquire; unmaps on the last one.
+ * Returns: 0 on success; -1 if not acquired or hal_close fails.
+ */
+
+int hal_lw_release(void) {
+    if (lw_users == 0) return -1;
+    if (--lw_users > 0) return 0;
+
+    hal_lw_base = NULL;
+    return hal_close(&lw_map);
+}
@@ -0,0 +1,187 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#include "../../lib/address_map_arm.h"
+#include "../../includes/hal/hal-regs.h"
+#include "../../includes/hal/hal-sim.h"
+#include "../../includes/hal/hal-trace.h"
+
+//?------------------------------------------------------------------------
+//?     CONSTANTS
+//?------------------------------------------------------------------------
+#define REG_INDEX(off)    ((off) / sizeof(uint32_t))
+#define INPUT_REGS        3                   // SW, KEY, KEY edge-capture
+
+//?------------------------------------------------------------------------
+//?     GLOBALS
+//?------------------------------------------------------------------------
+static uint32_t sim_regs[LW_BRIDGE_SPAN / sizeof(uint32_t)];
+
+// Replayed input stream: the changes seen by recorded SW/KEY reads, with
+// timestamps rebased to the first record of the trace and moved back to
+// when the change is applied (see replay_load).
+static hal_trace_record_t *inputs = NULL;
+static size_t input_count = 0;
+static size_t input_next = 0;
+static uint64_t replay_length_ns = 0;
+static uint64_t replay_start_ns = 0;
+static int replay_state = 0;   // 0 = not checked, 1 = active, -1 = off/done
+
+//?------------------------------------------------------------------------
+//?     REPLAY
+//?------------------------------------------------------------------------
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int input_slot(unsigned int offset) {
+    if (offset == SW_BASE) return 0;
+    if (offset == KEY_BASE) return 1;
+    if (offset == KEY_EDGE_BASE) return 2;
+    return -1;
+}
+
+static int compare_time(const void *a, const void *b) {
+    uint64_t ta = ((const hal_trace_record_t *)a)->timestamp_ns;
+    uint64_t tb = ((const hal_trace_record_t *)b)->timestamp_ns;
+    return (ta > tb) - (ta < tb);
+}
+
+/*
+ * replay_load
+ * Purpose: Load HAL_REPLAY (if set) and turn its input reads into a list
+ *          of input changes.
+ * Returns: void; leaves replay_state at 1 when a replay is active.
+ * Notes:
+ *   A read that saw a new value (any nonzero edge-capture value) only
+ *   tells us the input changed after the previous read of that register.
+ *   Applying it at the read's own timestamp would race the replayed
+ *   binary's read at almost the same instant, so the change is applied
+ *   midway between the two reads: a replay sampling at the recorded
+ *   times, give or take half a sample interval, sees it at the same read.
+ *   The first read of a register is applied from the start. Reads that
+ *   saw no change are dropped.
+ */
+
+static void replay_load(void) {
+    replay_state = -1;
+
+    const char *path = getenv("HAL_REPLAY");
+    if (!path || !*path) return;
+
+    hal_trace_record_t *records;
+    size_t count;
+    if (hal_trace_load(path, &records, &count) != 0 || count == 0) return;
+
+    uint64_t first = records[0].timestamp_ns;
+    replay_length_ns = records[count - 1].timestamp_ns - first;
+
+    uint64_t prev_ns[INPUT_REGS];
+    uint32_t prev_value[INPUT_REGS];
+    int seen[INPUT_REGS] = { 0 };
+
+    for (size_t i = 0; i < count; i++) {
+        int slot = input_slot(records[i].offset);
+        if (records[i].op != HAL_TRACE_READ || slot < 0) continue;
+
+        hal_trace_record_t in = records[i];
+        uint64_t t = in.timestamp_ns - first;
+        int changed = in.offset == KEY_EDGE_BASE ? in.value != 0
+                                                 : !seen[slot] || in.value != prev_value[slot];
+        if (changed) {
+            in.timestamp_ns = seen[slot] ? prev_ns[slot] + (t - prev_ns[slot]) / 2 : 0;
+            records[input_count++] = in;
+        }
+        seen[slot] = 1;
+        prev_ns[slot] = t;
+        prev_value[slot] = in.value;
+    }
+    qsort(records, input_count, sizeof(records[0]), compare_time);
+    inputs = records;
+    replay_state = 1;
+
+    fprintf(stderr, "Replay: %zu input changes over %.3f s from %s\n",
+            input_count, replay_length_ns / 1e9, path);
+}
+
+/*
+ * replay_advance
+ * Purpose: Apply every recorded input change whose time has come.
+ * Returns: void
+ * Notes:
+ *   Level registers (SW, KEY data) take the recorded value. Edge-capture
+ *   presses are OR-ed in so each recorded press is seen once until the
+ *   driver clears it. Raises SIGTERM when the recorded run is over.
+ */
+
+static void replay_advance(void) {
+    // The recorded timeline starts at its first access, so does the replay.
+    if (replay_start_ns == 0) replay_start_ns = now_ns();
+    uint64_t elapsed = now_ns() - replay_start_ns;
+
+    while (input_next < input_count && inputs[input_next].timestamp_ns <= elapsed) {
+        const hal_trace_record_t *in = &inputs[input_next++];
+        if (in->offset == KEY_EDGE_BASE) {
+            sim_regs[REG_INDEX(in->offset)] |= in->value;
+        } else {
+            sim_regs[REG_INDEX(in->offset)] = in->value;
+        }
+    }
+
+    if (elapsed > replay_length_ns) {
+        replay_state = -1;
+        raise(SIGTERM);
+    }
+}
+
+//?------------------------------------------------------------------------
+//?     REGISTER FILE
+//?------------------------------------------------------------------------
+
+/*
+ * hal_sim_base
+ * Purpose: Base of the simulated LW bridge window (shared by every map).
+ * Returns: Pointer to a zero-initialized LW_BRIDGE_SPAN register file.
+ */
+
+void *hal_sim_base(void) {
+    if (replay_state == 0) replay_load();
+    return sim_regs;
+}
+
+/*
+ * hal_sim_before_read
+ * Purpose: Bring replayed inputs up to date before a register is sampled.
+ * Params:  reg - register about to be read.
+ * Returns: void
+ */
+
+void hal_sim_before_read(const volatile uint32_t *reg) {
+    (void)reg;
+    if (replay_state == 1) replay_advance();
+}
+
+/*
+ * hal_sim_write
+ * Purpose: Store to the simulated register file with device semantics.
+ * Params:
+ *   reg   - register inside the simulated window.
+ *   value - value written.
+ * Returns: void
+ * Notes: The KEY edge-capture register is write-one-to-clear.
+ */
+
+void hal_sim_write(volatile uint32_t *reg, uint32_t value) {
+    if (replay_state == 1) replay_advance();
+    if (reg == &sim_regs[REG_INDEX(KEY_EDGE_BASE)]) {
+        *reg &= ~value;
+    } else {
+        *reg = value;
+    }
+}
@@ -0,0 +1,283 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../../lib/address_map_arm.h"
+#include "../../includes/hal/hal-trace.h"
+
+//?------------------------------------------------------------------------
+//?     CONSTANTS
+//?------------------------------------------------------------------------
+#define HAL_TRACE_MAX_MAPS   8
+#define HAL_TRACE_RING_MASK  (HAL_TRACE_RING_RECORDS - 1)
+
+//?------------------------------------------------------------------------
+//?     GLOBALS
+//?------------------------------------------------------------------------
+typedef struct {
+    const char *base;
+    unsigned int span;
+} trace_window_t;
+
+static trace_window_t windows[HAL_TRACE_MAX_MAPS];
+
+// Single-producer / single-consumer ring; head is owned by the HAL caller,
+// tail by the writer thread.
+static hal_trace_record_t ring[HAL_TRACE_RING_RECORDS];
+static atomic_size_t ring_head;
+static atomic_size_t ring_tail;
+static atomic_ulong dropped;
+static atomic_int stopping;
+
+static FILE *trace_file = NULL;
+static pthread_t writer;
+static int started = 0;
+static unsigned long written = 0;
+
+//?------------------------------------------------------------------------
+//?     WRITER THREAD
+//?------------------------------------------------------------------------
+
+/*
+ * drain_ring
+ * Purpose: Write every record published by the producer to the trace file.
+ * Returns: void
+ * Notes: At most two fwrite calls (the ring may wrap once).
+ */
+
+static void drain_ring(void) {
+    size_t head = atomic_load_explicit(&ring_head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+
+    while (tail != head) {
+        size_t start = tail & HAL_TRACE_RING_MASK;
+        size_t count = head - tail;
+        if (count > HAL_TRACE_RING_RECORDS - start) count = HAL_TRACE_RING_RECORDS - start;
+
+        written += fwrite(&ring[start], sizeof(ring[0]), count, trace_file);
+        tail += count;
+        atomic_store_explicit(&ring_tail, tail, memory_order_release);
+    }
+}
+
+static void *writer_main(void *arg) {
+    (void)arg;
+    const struct timespec period = { 0, HAL_TRACE_FLUSH_MS * 1000000L };
+
+    while (!atomic_load(&stopping)) {
+        drain_ring();
+        nanosleep(&period, NULL);
+    }
+    drain_ring();
+    return NULL;
+}
+
+/*
+ * trace_start
+ * Purpose: Open the trace file, write the header and start the writer thread.
+ * Returns: 0 on success; -1 on failure (tracing stays disabled).
+ */
+
+static int trace_start(void) {
+    const char *path = getenv("HAL_TRACE_FILE");
+    if (!path || !*path) path = HAL_TRACE_DEFAULT_FILE;
+
+    trace_file = fopen(path, "wb");
+    if (!trace_file) {
+        perror("ERROR: could not open register trace");
+        return -1;
+    }
+
+    hal_trace_header_t header = { .version = HAL_TRACE_VERSION,
+                                  .record_size = sizeof(hal_trace_record_t),
+                                  .lw_bridge_span = LW_BRIDGE_SPAN };
+    memcpy(header.magic, HAL_TRACE_MAGIC, sizeof(header.magic));
+    fwrite(&header, sizeof(header), 1, trace_file);
+
+    if (pthread_create(&writer, NULL, writer_main, NULL) != 0) {
+        fprintf(stderr, "ERROR: could not start register trace writer\n");
+        fclose(trace_file);
+        trace_file = NULL;
+        return -1;
+    }
+
+    started = 1;
+    atexit(hal_trace_stop);
+    fprintf(stderr, "Register trace: writing to %s\n", path);
+    return 0;
+}
+
+//?------------------------------------------------------------------------
+//?     RECORDING
+//?------------------------------------------------------------------------
+
+/*
+ * hal_trace_attach
+ * Purpose: Register a mapped LW bridge window so accesses through it can be
+ *          translated back to bridge offsets. Starts the trace on first use.
+ * Params:
+ *   virtual_base - process-virtual base returned by hal_open.
+ *   span         - window size in bytes.
+ * Returns:
+ *   0 on success; -1 if the window table is full or the trace cannot start.
+ */
+
+int hal_trace_attach(const void *virtual_base, unsigned int span) {
+    if (!started && trace_start() != 0) return -1;
+
+    for (int i = 0; i < HAL_TRACE_MAX_MAPS; i++) {
+        if (windows[i].base == NULL) {
+            windows[i].base = virtual_base;
+            windows[i].span = span;
+            return 0;
+        }
+    }
+    fprintf(stderr, "Register trace: too many mapped windows\n");
+    return -1;
+}
+
+/*
+ * hal_trace_detach
+ * Purpose: Forget a window registered with hal_trace_attach.
+ * Params:  virtual_base - base passed to hal_trace_attach.
+ * Returns: void
+ */
+
+void hal_trace_detach(const void *virtual_base) {
+    for (int i = 0; i < HAL_TRACE_MAX_MAPS; i++) {
+        if (windows[i].base == virtual_base) {
+            windows[i].base = NULL;
+            windows[i].span = 0;
+            return;
+        }
+    }
+}
+
+/*
+ * hal_trace_record
+ * Purpose: Append one MMIO access to the trace ring.
+ * Params:
+ *   op    - HAL_TRACE_READ or HAL_TRACE_WRITE.
+ *   reg   - register pointer inside an attached window.
+ *   value - value read or written.
+ * Returns: void
+ * Notes:
+ *   Never blocks. If the writer falls behind the record is dropped and
+ *   counted; accesses outside any attached window are ignored.
+ */
+
+void hal_trace_record(int op, const volatile uint32_t *reg, uint32_t value) {
+    if (!started) return;
+
+    const char *addr = (const char *)reg;
+    int i;
+    for (i = 0; i < HAL_TRACE_MAX_MAPS; i++) {
+        if (windows[i].base && addr >= windows[i].base &&
+            addr < windows[i].base + windows[i].span) break;
+    }
+    if (i == HAL_TRACE_MAX_MAPS) return;
+
+    size_t head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_tail, memory_order_acquire);
+    if (head - tail >= HAL_TRACE_RING_RECORDS) {
+        atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    hal_trace_record_t *rec = &ring[head & HAL_TRACE_RING_MASK];
+    rec->timestamp_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    rec->value = value;
+    rec->offset = (uint16_t)(addr - windows[i].base);
+    rec->op = (uint8_t)op;
+    rec->reserved = 0;
+
+    atomic_store_explicit(&ring_head, head + 1, memory_order_release);
+}
+
+/*
+ * hal_trace_stop
+ * Purpose: Flush outstanding records, stop the writer and close the file.
+ * Returns: void
+ * Notes: Registered with atexit on start; safe to call more than once.
+ */
+
+void hal_trace_stop(void) {
+    if (!started) return;
+    started = 0;
+
+    atomic_store(&stopping, 1);
+    pthread_join(writer, NULL);
+    fclose(trace_file);
+    trace_file = NULL;
+
+    fprintf(stderr, "Register trace: %lu records written, %lu dropped\n",
+            written, (unsigned long)atomic_load(&dropped));
+}
+
+//?------------------------------------------------------------------------
+//?     LOADING
+//?------------------------------------------------------------------------
+
+/*
+ * hal_trace_load
+ * Purpose: Read a complete trace file into memory.
+ * Params:
+ *   path    - trace file written by a -DHAL_TRACE build.
+ *   records - out parameter; malloc'd record array (caller frees).
+ *   count   - out parameter; number of records.
+ * Returns:
+ *   0 on success; -1 on I/O error or bad header (stderr contains reason).
+ */
+
+int hal_trace_load(const char *path, hal_trace_record_t **records, size_t *count) {
+    if (!path || !records || !count) return -1;
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror("ERROR: could not open register trace");
+        return -1;
+    }
+
+    hal_trace_header_t header;
+    if (fread(&header, sizeof(header), 1, f) != 1 ||
+        memcmp(header.magic, HAL_TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != HAL_TRACE_VERSION ||
+        header.record_size != sizeof(hal_trace_record_t)) {
+        fprintf(stderr, "ERROR: %s is not a register trace\n", path);
+        fclose(f);
+        return -1;
+    }
+
+    size_t capacity = 1024;
+    size_t n = 0;
+    hal_trace_record_t *buf = malloc(capacity * sizeof(*buf));
+    while (buf) {
+        n += fread(&buf[n], sizeof(*buf), capacity - n, f);
+        if (n < capacity) break;
+        hal_trace_record_t *grown = realloc(buf, 2 * capacity * sizeof(*buf));
+        if (!grown) {
+            free(buf);
+            buf = NULL;
+            break;
+        }
+        buf = grown;
+        capacity *= 2;
+    }
+    fclose(f);
+
+    if (!buf) {
+        fprintf(stderr, "ERROR: out of memory loading %s\n", path);
+        return -1;
+    }
+
+    *records = buf;
+    *count = n;
+    return 0;
+}
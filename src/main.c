@@ -1,57 +1,680 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdint.h>
-#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
 
 #include "../includes/peripherals/hex-display.h"
+#include "../includes/peripherals/hex-marquee.h"
+#include "../includes/peripherals/led.h"
+#include "../includes/peripherals/switch.h"
+#include "../includes/peripherals/key.h"
+#include "../includes/clock/timebase.h"
+#include "../includes/clock/display-sched.h"
+#include "../includes/clock/alarm.h"
+#include "../includes/clock/stopwatch.h"
+#include "../includes/clock/world-clock.h"
+
+#define SECONDS_PER_DAY        86400
+#define FLASH_HALF_PERIOD_NS   (500 * NS_PER_MS)
+#define ALARM_DEFAULT_HOLD     10      // seconds an alarm's LEDs / flash last
+#define ALARM_LINE_MAX         128
+#define MARQUEE_FRAME_NS       (300 * NS_PER_MS)
+#define ALARM_TEXT             "ALArn"
+
+#define SW_MODE_STOPWATCH      (1u << 9)
+#define SW_MODE_COUNTDOWN      (1u << 8)   // SW9 wins if both are up
+#define SW_ZONE_MASK           0xFu        // SW3..SW0 select the world-clock zone
+#define KEY_START_STOP         (1u << 0)
+#define KEY_LAP                (1u << 1)   // countdown: +1 minute while stopped
+#define KEY_RESET              (1u << 2)
+#define COUNTDOWN_DEFAULT_NS   (5 * 60 * NS_PER_SEC)
+#define COUNTDOWN_MAX_NS       ((99 * 60 + 59) * NS_PER_SEC)
+
+typedef enum {
+    MODE_CLOCK,
+    MODE_STOPWATCH,
+    MODE_COUNTDOWN
+} app_mode_t;
+
+typedef struct {
+    uint64_t t0;                // monotonic time at start
+    uint64_t start_ns;          // time of day at t0
+    int show_seconds;
+
+    display_sched_t sched;
+    int clock_source;
+    world_clock_t world;        // zone 0 is local time; alarms use local time
+    int zone;
+    uint64_t zone_change_ns;    // earliest time a pending zone change can have happened, else 0
+    uint64_t zone_switches;
+    uint64_t zone_worst_ns;     // worst bound: previous input sample to register write
+    alarm_wheel_t wheel;        // ticks = seconds since midnight of the start day
+
+    int flash_source;
+    uint64_t flash_start_ns;
+    uint64_t flash_end_ns;      // 0 when no flash is running
+    uint32_t alarm_words[2];    // pre-rendered ALARM_TEXT (HEX3_HEX0, HEX5_HEX4)
+
+    int marquee_source;
+    uint64_t marquee_start_ns;
+    int marquee_active;
+    hex_marquee_t marquee;
+
+    led_handle_t led;
+    int led_ready;
+    alarm_id_t led_release;
+
+    switch_handle_t sw;
+    key_handle_t key;
+    int inputs_ready;
+    uint64_t input_sample_ns;   // time of the last input sample, 0 before the first
+    uint64_t poll_ns;           // extra clock-mode input polling; 0 = none
+    int poll_source;
+
+    app_mode_t mode;
+    stopwatch_t stopwatch;
+    stopwatch_t countdown;
+    int centi_source;           // STOPWATCH_TICK_NS frames of the shown stopwatch
+} clock_app_t;
+
+static clock_app_t app;
+
+static volatile sig_atomic_t running = 1;
+
+static void handle_stop(int sig) {
+    (void)sig;
+    running = 0;
+}
+
+/*
+ * parse_hms
+ * Purpose: Parse "HH:MM:SS" into seconds since midnight.
+ * Returns: 0 on success; -1 on malformed or out-of-range input.
+ */
+
+static int parse_hms(const char *text, int *seconds_of_day) {
+    int h, m, s;
+    char extra;
+    if (sscanf(text, "%d:%d:%d%c", &h, &m, &s, &extra) != 3) return -1;
+    if (h < 0 || h > 23 || m < 0 || m > 59 || s < 0 || s > 59) return -1;
+    *seconds_of_day = h * 3600 + m * 60 + s;
+    return 0;
+}
+
+/*
+ * parse_ms
+ * Purpose: Parse a countdown length "MM:SS" (00:01 to 99:59).
+ * Returns: 0 on success; -1 on malformed or out-of-range input.
+ */
+
+static int parse_ms(const char *text, uint64_t *length_ns) {
+    int m, s;
+    char extra;
+    if (sscanf(text, "%d:%d%c", &m, &s, &extra) != 2) return -1;
+    if (m < 0 || m > 99 || s < 0 || s > 59 || m + s == 0) return -1;
+    *length_ns = (uint64_t)(m * 60 + s) * NS_PER_SEC;
+    return 0;
+}
+
+//?------------------------------------------------------------------------
+//?     ALARMS
+//?------------------------------------------------------------------------
+
+static uint64_t clock_tick(const clock_app_t *a, uint64_t now_ns) {
+    return (now_ns - a->t0 + a->start_ns) / NS_PER_SEC;
+}
+
+static uint64_t tick_to_ns(const clock_app_t *a, uint64_t tick) {
+    return a->t0 + tick * NS_PER_SEC - a->start_ns;
+}
+
+static void start_flash(clock_app_t *a, uint64_t at_ns, uint32_t seconds) {
+    a->flash_start_ns = at_ns;
+    a->flash_end_ns = at_ns + (uint64_t)seconds * NS_PER_SEC;
+    display_sched_set_phase(&a->sched, a->flash_source, at_ns);
+    display_sched_enable(&a->sched, a->flash_source, 1);
+}
+
+static void led_release(void *ctx, alarm_id_t id) {
+    clock_app_t *a = ctx;
+    (void)id;
+    a->led_release = ALARM_ID_NONE;
+    if (a->led_ready) led_set_inline(&a->led, LED_ALL_OFF);
+}
+
+/*
+ * on_alarm
+ * Purpose: Carry out an expired alarm's action.
+ * Params:
+ *   ctx  - clock_app_t.
+ *   id   - expired alarm.
+ *   spec - its action.
+ * Returns: void
+ * Notes:
+ *   LED patterns are released by a follow-up one-shot alarm; a newer LED
+ *   alarm cancels the pending release of an older one.
+ */
+
+static void on_alarm(void *ctx, alarm_id_t id, const alarm_spec_t *spec) {
+    clock_app_t *a = ctx;
+    uint64_t at = tick_to_ns(a, a->wheel.now);
+
+    switch (spec->action) {
+        case ALARM_ACTION_LED_PATTERN: {
+            if (a->led_ready) led_set_inline(&a->led, spec->arg);
+            if (a->led_release != ALARM_ID_NONE) alarm_cancel(&a->wheel, a->led_release);
+            alarm_spec_t release = { .action = ALARM_ACTION_CALLBACK, .callback = led_release, .ctx = a };
+            a->led_release = alarm_add(&a->wheel, a->wheel.now + spec->duration, &release);
+            break;
+        }
+        case ALARM_ACTION_HEX_FLASH:
+            start_flash(a, at, spec->duration);
+            break;
+        case ALARM_ACTION_CALLBACK:
+            if (spec->callback) spec->callback(spec->ctx, id);
+            break;
+    }
+}
+
+/*
+ * load_alarm
+ * Purpose: Parse one alarm description and add it to the wheel.
+ * Params:
+ *   text - "HH:MM:SS[,flash][,led=MASK][,for=SECONDS][,daily]".
+ *          With neither flash nor led the alarm flashes the display.
+ * Returns:
+ *   0 on success; -1 on a malformed description or a full wheel.
+ */
+
+static int load_alarm(clock_app_t *a, const char *text) {
+    char buf[ALARM_LINE_MAX];
+    if (strlen(text) >= sizeof(buf)) return -1;
+    strcpy(buf, text);
+
+    char *field = strtok(buf, ",");
+    int when;
+    if (!field || parse_hms(field, &when) != 0) return -1;
+
+    int flash = 0, led = 0;
+    uint32_t pattern = 0, hold = ALARM_DEFAULT_HOLD, period = 0;
+    while ((field = strtok(NULL, ",")) != NULL) {
+        char *end;
+        if (strcmp(field, "flash") == 0) {
+            flash = 1;
+        } else if (strncmp(field, "led=", 4) == 0) {
+            pattern = (uint32_t)strtoul(field + 4, &end, 0);
+            if (*end) return -1;
+            led = 1;
+        } else if (strncmp(field, "for=", 4) == 0) {
+            hold = (uint32_t)strtoul(field + 4, &end, 0);
+            if (*end || hold == 0) return -1;
+        } else if (strcmp(field, "daily") == 0) {
+            period = SECONDS_PER_DAY;
+        } else {
+            return -1;
+        }
+    }
+    if (!flash && !led) flash = 1;
+
+    // Next occurrence strictly after the current tick.
+    uint64_t now = a->wheel.now;
+    uint64_t expires = now - now % SECONDS_PER_DAY + (uint64_t)when;
+    if (expires <= now) expires += SECONDS_PER_DAY;
+
+    if (flash) {
+        alarm_spec_t spec = { .action = ALARM_ACTION_HEX_FLASH, .duration = hold, .period = period };
+        if (alarm_add(&a->wheel, expires, &spec) == ALARM_ID_NONE) return -1;
+    }
+    if (led) {
+        alarm_spec_t spec = { .action = ALARM_ACTION_LED_PATTERN, .arg = pattern & LED_ALL_ON,
+                              .duration = hold, .period = period };
+        if (alarm_add(&a->wheel, expires, &spec) == ALARM_ID_NONE) return -1;
+    }
+    return 0;
+}
+
+/*
+ * load_alarm_file
+ * Purpose: Add every alarm listed in a file, one description per line.
+ * Returns: 0 on success; -1 on I/O error or the first bad line.
+ * Notes:   Blank lines and lines starting with '#' are ignored.
+ */
+
+static int load_alarm_file(clock_app_t *a, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror("ERROR: could not open alarm file");
+        return -1;
+    }
+
+    char line[ALARM_LINE_MAX];
+    int line_no = 0;
+    int rc = 0;
+    while (rc == 0 && fgets(line, sizeof(line), f)) {
+        line_no++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+        if (load_alarm(a, line) != 0) {
+            fprintf(stderr, "%s:%d: invalid alarm: %s\n", path, line_no, line);
+            rc = -1;
+        }
+    }
+    fclose(f);
+    return rc;
+}
+
+//?------------------------------------------------------------------------
+//?     STOPWATCH
+//?------------------------------------------------------------------------
+
+static stopwatch_t *shown_stopwatch(clock_app_t *a) {
+    if (a->mode == MODE_STOPWATCH) return &a->stopwatch;
+    if (a->mode == MODE_COUNTDOWN) return &a->countdown;
+    return NULL;
+}
+
+/*
+ * update_sources
+ * Purpose: Enable the wakeups the current mode needs. Clock mode: second/
+ *          minute boundaries, plus --poll-ms polling if requested. Stopwatch
+ *          shown: centisecond frames (aligned to the stopwatch while it
+ *          runs), which also time KEY presses to frame resolution.
+ *          Call after any mode or run change.
+ * Returns: void
+ */
+
+static void update_sources(clock_app_t *a) {
+    stopwatch_t *sw = shown_stopwatch(a);
+
+    display_sched_enable(&a->sched, a->clock_source, sw == NULL);
+    display_sched_enable(&a->sched, a->poll_source, sw == NULL && a->inputs_ready && a->poll_ns);
+    if (sw && sw->running) display_sched_set_phase(&a->sched, a->centi_source, stopwatch_phase(sw));
+    display_sched_enable(&a->sched, a->centi_source, sw != NULL);
+}
+
+// Monotonic time at which the running countdown reaches zero.
+static uint64_t countdown_end(const clock_app_t *a) {
+    if (!a->countdown.running) return DISPLAY_SCHED_NEVER;
+    return a->countdown.started_ns + a->countdown.preset_ns - a->countdown.banked_ns;
+}
+
+/*
+ * check_countdown
+ * Purpose: Stop a countdown that reached zero and flash the alarm text.
+ * Returns: void
+ * Notes:   Runs whatever the mode; the main loop wakes at countdown_end.
+ */
+
+static void check_countdown(clock_app_t *a, uint64_t now_ns) {
+    if (!a->countdown.running || !stopwatch_finished(&a->countdown, now_ns)) return;
+
+    stopwatch_stop(&a->countdown, now_ns);
+    stopwatch_report(&a->countdown, "countdown", stdout);
+    start_flash(a, now_ns, ALARM_DEFAULT_HOLD);
+    update_sources(a);
+}
+
+/*
+ * handle_keys
+ * Purpose: Apply KEY presses to the shown stopwatch.
+ * Params:
+ *   presses - latched presses (KEY_START_STOP, KEY_LAP, KEY_RESET).
+ * Returns: void
+ */
+
+static void handle_keys(clock_app_t *a, uint32_t presses, uint64_t now_ns) {
+    stopwatch_t *sw = shown_stopwatch(a);
+    if (!sw) return;
+    const char *name = sw == &a->stopwatch ? "stopwatch" : "countdown";
+
+    if (presses & KEY_START_STOP) {
+        if (sw->running) {
+            stopwatch_stop(sw, now_ns);
+            stopwatch_report(sw, name, stdout);
+        } else {
+            stopwatch_start(sw, now_ns);
+        }
+    }
+
+    if (presses & KEY_LAP) {
+        if (sw->direction == STOPWATCH_UP) {
+            int lap = stopwatch_lap(sw, now_ns);
+            if (lap >= 0) {
+                char text[STOPWATCH_TEXT_MAX];
+                stopwatch_format(sw->laps[lap], text);
+                printf("%s: lap %d %s\n", name, lap + 1, text);
+            }
+        } else if (!sw->running) {
+            sw->preset_ns += 60 * NS_PER_SEC;
+            if (sw->preset_ns > COUNTDOWN_MAX_NS) sw->preset_ns = 60 * NS_PER_SEC;
+        }
+    }
+
+    if (presses & KEY_RESET) stopwatch_reset(sw);
+    update_sources(a);
+}
+
+/*
+ * poll_inputs
+ * Purpose: Sample the mode switches and KEY presses on a wakeup.
+ * Params:
+ *   a      - application state.
+ *   now_ns - monotonic time of this wakeup.
+ * Returns: void
+ * Notes:
+ *   Inputs ride on wakeups the display needs anyway (two loads each), so
+ *   they add no wakeups of their own unless --poll-ms asks for them.
+ *   Presses are latched by the edge-capture register, so none are lost
+ *   between samples; a press is timed to the wakeup that reads it. Presses
+ *   read in the same sample as a mode change are discarded.
+ */
+
+static void poll_inputs(clock_app_t *a, uint64_t now_ns) {
+    if (!a->inputs_ready) return;
+
+    uint32_t switches = switch_read_all_inline(&a->sw);
+    uint64_t prev_sample_ns = a->input_sample_ns;
+    a->input_sample_ns = now_ns;
+
+    // The switch moved at some point after the previous sample.
+    int zone = (int)(switches & SW_ZONE_MASK);
+    if (zone != a->zone) {
+        a->zone = zone;
+        a->zone_change_ns = prev_sample_ns;
+    }
+
+    app_mode_t mode = (switches & SW_MODE_STOPWATCH) ? MODE_STOPWATCH :
+                      (switches & SW_MODE_COUNTDOWN) ? MODE_COUNTDOWN : MODE_CLOCK;
+    int mode_changed = mode != a->mode;
+    if (mode_changed) {
+        stopwatch_t *hidden = shown_stopwatch(a);
+        if (hidden) stopwatch_account_break(hidden);
+        a->mode = mode;
+        update_sources(a);
+    }
+
+    // Presses latched before the new mode was on screen are dropped: they
+    // could be up to a sample interval old and were not meant for it.
+    uint32_t presses = key_read_presses_inline(&a->key);
+    if (presses && !mode_changed) handle_keys(a, presses, now_ns);
+}
+
+//?------------------------------------------------------------------------
+//?     DISPLAY
+//?------------------------------------------------------------------------
+
+/*
+ * render_clock
+ * Purpose: Show the selected zone's time of day as HH MM SS.
+ * Params:
+ *   a      - application state.
+ *   now_ns - monotonic time of this frame.
+ * Returns: void
+ * Notes:
+ *   All zones are advanced here, so their cached words are always current
+ *   and a zone switch only stores the new zone's words (one store when the
+ *   hours agree, two otherwise). For each change the worst-case latency
+ *   is recorded: from the previous input sample, when the switch could
+ *   first have moved, to the register write. It is dominated by the
+ *   sample interval, not by the render.
+ */
+
+static void render_clock(clock_app_t *a, uint64_t now_ns) {
+    world_clock_advance(&a->world, clock_tick(a, now_ns));
+    const uint32_t *words = world_clock_words(&a->world, a->zone);
+    hex_display_write_words_inline(words[0], words[1]);
+
+    if (a->zone_change_ns) {
+        uint64_t latency = timebase_now_ns() - a->zone_change_ns;
+        if (latency > a->zone_worst_ns) a->zone_worst_ns = latency;
+        a->zone_switches++;
+        a->zone_change_ns = 0;
+    }
+}
+
+/*
+ * render_stopwatch
+ * Purpose: Show a stopwatch as MM:SS.cc and account the frame if running.
+ * Returns: void
+ * Notes:   Most frames change only HEX3_HEX0, so they cost one store.
+ */
+
+static void render_stopwatch(clock_app_t *a, stopwatch_t *sw, uint64_t now_ns) {
+    uint32_t hex3_hex0, hex5_hex4;
+    stopwatch_words(stopwatch_display_ns(sw, now_ns), &hex3_hex0, &hex5_hex4);
+    int writes = hex_display_write_words_inline(hex3_hex0, hex5_hex4);
+    if (sw->running) stopwatch_account(sw, a->sched.woke_for_ns, now_ns, writes > 0);
+}
+
+/*
+ * render
+ * Purpose: Draw the current frame. An alarm flash shows the alarm text on
+ *          alternate half-periods, over a scrolling message, the stopwatch
+ *          or the clock.
+ * Params:
+ *   a      - application state.
+ *   now_ns - monotonic time of this frame.
+ * Returns: void
+ */
+
+static void render(clock_app_t *a, uint64_t now_ns) {
+    if (a->flash_end_ns) {
+        if (now_ns >= a->flash_end_ns) {
+            a->flash_end_ns = 0;
+            display_sched_enable(&a->sched, a->flash_source, 0);
+        } else if (((now_ns - a->flash_start_ns) / FLASH_HALF_PERIOD_NS) % 2 == 0) {
+            hex_display_write_words_inline(a->alarm_words[0], a->alarm_words[1]);
+            return;
+        }
+    }
+
+    if (a->marquee_active) {
+        uint64_t step = (now_ns - a->marquee_start_ns) / MARQUEE_FRAME_NS;
+        if (step < (uint64_t)a->marquee.steps) {
+            uint32_t hex3_hex0, hex5_hex4;
+            hex_marquee_frame(&a->marquee, (int)step, &hex3_hex0, &hex5_hex4);
+            hex_display_write_words_inline(hex3_hex0, hex5_hex4);
+            return;
+        }
+        a->marquee_active = 0;
+        display_sched_enable(&a->sched, a->marquee_source, 0);
+    }
+
+    stopwatch_t *sw = shown_stopwatch(a);
+    if (sw) {
+        render_stopwatch(a, sw, now_ns);
+        return;
+    }
+    render_clock(a, now_ns);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s [--start HH:MM:SS] [--hhmm] [--demo] [--message TEXT]\n"
+            "          [--alarm HH:MM:SS[,flash][,led=MASK][,for=SECONDS][,daily]]...\n"
+            "          [--alarms FILE]... [--countdown MM:SS] [--poll-ms N]\n"
+            "          [--zone +HH:MM|-HH:MM]...\n", prog);
+}
 
 /*
  * main
  * Purpose: Run a simple clock on HEX0..HEX5 using MMIO via HAL.
  * Behavior:
- *   Initializes HEX blocks, maintains hh:mm:ss with 1 s ticks,
- *   handles rollovers, writes digits to HEX displays each loop,
- *   then clears displays and closes resources on exit.
+ *   Derives the time of day from one monotonic time base and sleeps
+ *   (tickless) until the rendered output next changes: every second, or
+ *   every minute with --hhmm, or the next alarm. Alarms are kept in a
+ *   timing wheel advanced to the current second on every wakeup; an alarm
+ *   flash alternates "ALArn" with the time. An optional --message scrolls
+ *   across the displays first. SW9 switches to a stopwatch and SW8 to a
+ *   countdown, shown as MM:SS.cc at 100 Hz while running (KEY0 start/stop,
+ *   KEY1 lap or +1 minute, KEY2 reset). SW3..SW0 pick the zone shown in
+ *   clock mode (--zone offsets; 0 = local). Inputs are sampled on every
+ *   wakeup: each clock tick (optionally every --poll-ms) in clock mode and
+ *   every centisecond frame while a stopwatch is shown.
+ *   Prints wakeup/CPU stats hourly and on exit, then clears displays and
+ *   closes resources (SIGINT/SIGTERM).
  * Returns:
- *   0 on normal exit; nonzero on initialization failure.
+ *   0 on normal exit; nonzero on bad arguments or initialization failure.
  */
 
-int main(void) {
+int main(int argc, char **argv) {
+    int start_of_day = 12 * 3600;
+    int demo = 0;
+    const char *alarm_args[argc];
+    int alarm_arg_count = 0;
+    const char *message = NULL;
+    uint64_t countdown_ns = COUNTDOWN_DEFAULT_NS;
+    long poll_ms = 0;
+    int32_t zone_offsets[WORLD_CLOCK_MAX_ZONES];
+    int zone_count = 1;
+
+    app.show_seconds = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--start") == 0 && i + 1 < argc) {
+            if (parse_hms(argv[++i], &start_of_day) != 0) {
+                fprintf(stderr, "Invalid --start time: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--hhmm") == 0) {
+            app.show_seconds = 0;
+        } else if (strcmp(argv[i], "--demo") == 0) {
+            demo = 1;
+        } else if (strcmp(argv[i], "--message") == 0 && i + 1 < argc) {
+            message = argv[++i];
+            if (hex_marquee_init(&app.marquee, message) != 0) {
+                fprintf(stderr, "--message is limited to %d characters\n", HEX_MARQUEE_MAX_TEXT);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--countdown") == 0 && i + 1 < argc) {
+            if (parse_ms(argv[++i], &countdown_ns) != 0) {
+                fprintf(stderr, "Invalid --countdown length: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--poll-ms") == 0 && i + 1 < argc) {
+            char *end;
+            poll_ms = strtol(argv[++i], &end, 10);
+            if (*end || poll_ms < 0 || poll_ms > 1000) {
+                fprintf(stderr, "Invalid --poll-ms (0-1000): %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--zone") == 0 && i + 1 < argc) {
+            if (zone_count >= WORLD_CLOCK_MAX_ZONES ||
+                world_clock_parse_offset(argv[++i], &zone_offsets[zone_count]) != 0) {
+                fprintf(stderr, "Invalid --zone (at most %d, -12:00 to +14:00): %s\n",
+                        WORLD_CLOCK_MAX_ZONES - 1, argv[i]);
+                return 1;
+            }
+            zone_count++;
+        } else if ((strcmp(argv[i], "--alarm") == 0 || strcmp(argv[i], "--alarms") == 0) && i + 1 < argc) {
+            alarm_args[alarm_arg_count++] = argv[i];
+            alarm_args[alarm_arg_count++] = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
     if (init_hex0_hex3() != 0 || init_hex4_hex5() != 0) {
         fprintf(stderr, "HEX init failed\n");
         return 1;
     }
 
-    int hours = 12;
-    int minutes = 0;
-    int seconds = 0;
+    if (demo) {
+        world_clock_init(&app.world, 12 * 3600 + 34 * 60 + 56, 1);
+        hex_display_write_words_inline(app.world.zones[0].words[0], app.world.zones[0].words[1]);
+        close_hex0_hex3();
+        close_hex4_hex5();
+        return 0;
+    }
+
+    // Wall time = monotonic time shifted so that t0 reads start_of_day.
+    app.t0 = timebase_now_ns();
+    app.start_ns = (uint64_t)start_of_day * NS_PER_SEC;
+    uint64_t period = app.show_seconds ? NS_PER_SEC : 60 * NS_PER_SEC;
+
+    display_sched_init(&app.sched, app.t0);
+    app.clock_source = display_sched_add_source(&app.sched, period, app.t0 + period - app.start_ns % period);
+    world_clock_init(&app.world, clock_tick(&app, app.t0), app.show_seconds);
+    for (int i = 1; i < zone_count; i++) world_clock_add_zone(&app.world, zone_offsets[i]);
+    app.flash_source = display_sched_add_source(&app.sched, FLASH_HALF_PERIOD_NS, app.t0);
+    display_sched_enable(&app.sched, app.flash_source, 0);
+    hex_display_render_text(ALARM_TEXT, &app.alarm_words[0], &app.alarm_words[1]);
+
+    // A --message scrolls once at MARQUEE_FRAME_NS per step before the clock shows.
+    app.marquee_source = display_sched_add_source(&app.sched, MARQUEE_FRAME_NS, app.t0);
+    app.marquee_start_ns = app.t0;
+    app.marquee_active = message != NULL;
+    display_sched_enable(&app.sched, app.marquee_source, app.marquee_active);
 
-    while (1) {
-        sleep(1);
-        seconds++;
-        if (seconds >= 60) {
-            seconds = 0;
-            minutes++;
-            if (minutes >= 60) {
-                minutes = 0;
-                hours = (hours + 1) % 24;
+    // Stopwatch modes; the first wakeup (at t0) picks the mode from the switches.
+    stopwatch_init(&app.stopwatch, STOPWATCH_UP, 0);
+    stopwatch_init(&app.countdown, STOPWATCH_DOWN, countdown_ns);
+    app.centi_source = display_sched_add_source(&app.sched, STOPWATCH_TICK_NS, app.t0);
+    display_sched_enable(&app.sched, app.centi_source, 0);
+
+    app.poll_ns = (uint64_t)poll_ms * NS_PER_MS;
+    if (switch_init(&app.sw) == 0) {
+        if (key_init(&app.key) == 0) app.inputs_ready = 1;
+        else switch_cleanup(&app.sw);
+    }
+    if (!app.inputs_ready) fprintf(stderr, "Inputs unavailable; clock mode only\n");
+    app.poll_source = display_sched_add_source(&app.sched, app.poll_ns ? app.poll_ns : NS_PER_SEC, app.t0);
+    display_sched_enable(&app.sched, app.poll_source, app.inputs_ready && app.poll_ns);
+
+    alarm_wheel_init(&app.wheel, clock_tick(&app, app.t0), on_alarm, &app);
+    for (int i = 0; i < alarm_arg_count; i += 2) {
+        int rc = strcmp(alarm_args[i], "--alarm") == 0 ? load_alarm(&app, alarm_args[i + 1])
+                                                       : load_alarm_file(&app, alarm_args[i + 1]);
+        if (rc != 0) {
+            if (strcmp(alarm_args[i], "--alarm") == 0) fprintf(stderr, "Invalid --alarm: %s\n", alarm_args[i + 1]);
+            if (app.inputs_ready) {
+                key_cleanup(&app.key);
+                switch_cleanup(&app.sw);
             }
+            close_hex0_hex3();
+            close_hex4_hex5();
+            return 1;
         }
+    }
+    if (app.wheel.active > 0) {
+        printf("%u alarms loaded\n", app.wheel.active);
+        app.led_ready = led_init(&app.led) == 0;
+    }
 
-        int h1 = hours / 10;
-        int h0 = hours % 10;
-        int m1 = minutes / 10;
-        int m0 = minutes % 10;
-        int s1 = seconds / 10;
-        int s0 = seconds % 10;
+    struct sigaction sa = { .sa_handler = handle_stop };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
 
-        hex_display_write(5, h1);
-        hex_display_write(4, h0);
-        hex_display_write(3, m1);
-        hex_display_write(2, m0);
-        hex_display_write(1, s1);
-        hex_display_write(0, s0);
+    // An interrupted wait just re-renders the same time, which writes nothing.
+    for (uint64_t now = app.t0; running; display_sched_wait(&app.sched, &now)) {
+        poll_inputs(&app, now);
+        alarm_wheel_advance(&app.wheel, clock_tick(&app, now));
+        check_countdown(&app, now);
+        render(&app, now);
+        app.zone_change_ns = 0;   // only changes shown at once count as latency samples
+
+        uint64_t next = alarm_wheel_next(&app.wheel);
+        uint64_t deadline = next == ALARM_NEVER ? DISPLAY_SCHED_NEVER : tick_to_ns(&app, next);
+        if (countdown_end(&app) < deadline) deadline = countdown_end(&app);
+        display_sched_set_deadline(&app.sched, deadline);
+    }
+
+    display_sched_report(&app.sched, stdout);
+    if (app.stopwatch.shown_ns || app.stopwatch.lap_count) stopwatch_report(&app.stopwatch, "stopwatch", stdout);
+    if (app.countdown.shown_ns) stopwatch_report(&app.countdown, "countdown", stdout);
+    if (app.zone_switches) {
+        printf("zones: %llu switches, shown at most %.3f ms after the switch moved (worst case)\n",
+               (unsigned long long)app.zone_switches, app.zone_worst_ns / 1e6);
     }
 
+    if (app.inputs_ready) {
+        key_cleanup(&app.key);
+        switch_cleanup(&app.sw);
+    }
+    if (app.led_ready) led_cleanup(&app.led);
     hex_display_clear_all();
     close_hex0_hex3();
     close_hex4_hex5();
@@ -2,13 +2,14 @@
 #include <stdint.h>
 #include <unistd.h>
 #include "../../includes/hal/hal-api.h"
+#include "../../includes/hal/hal-regs.h"
 #include "../../includes/peripherals/hex-display.h"
 #include "../../lib/address_map_arm.h"
 
 //?------------------------------------------------------------------------
 //?     CONSTANTS
 //?------------------------------------------------------------------------
-static const uint8_t seg_table[16] = {
+const uint8_t hex_display_seg_table[HEX_DIGIT_CODES] = {
     0x3F, // 0
     0x06, // 1
     0x5B, // 2
@@ -24,17 +25,46 @@ static const uint8_t seg_table[16] = {
     0x39, // C
     0x5E, // d
     0x79, // E
-    0x71  // F
+    0x71, // F
+    0x00  // HEX_BLANK
+};
+
+// ASCII -> segments for text. Letters use the usual 7-segment forms; where
+// only one case can be drawn both cases map to it. '*' is the degree sign.
+// Anything not listed renders blank.
+static const uint8_t glyph_table[128] = {
+    ['0'] = 0x3F, ['1'] = 0x06, ['2'] = 0x5B, ['3'] = 0x4F, ['4'] = 0x66,
+    ['5'] = 0x6D, ['6'] = 0x7D, ['7'] = 0x07, ['8'] = 0x7F, ['9'] = 0x6F,
+
+    ['A'] = 0x77, ['a'] = 0x77, ['B'] = 0x7C, ['b'] = 0x7C,
+    ['C'] = 0x39, ['c'] = 0x58, ['D'] = 0x5E, ['d'] = 0x5E,
+    ['E'] = 0x79, ['e'] = 0x79, ['F'] = 0x71, ['f'] = 0x71,
+    ['G'] = 0x3D, ['g'] = 0x3D, ['H'] = 0x76, ['h'] = 0x74,
+    ['I'] = 0x30, ['i'] = 0x10, ['J'] = 0x1E, ['j'] = 0x1E,
+    ['K'] = 0x75, ['k'] = 0x75, ['L'] = 0x38, ['l'] = 0x38,
+    ['M'] = 0x37, ['m'] = 0x37, ['N'] = 0x54, ['n'] = 0x54,
+    ['O'] = 0x3F, ['o'] = 0x5C, ['P'] = 0x73, ['p'] = 0x73,
+    ['Q'] = 0x67, ['q'] = 0x67, ['R'] = 0x50, ['r'] = 0x50,
+    ['S'] = 0x6D, ['s'] = 0x6D, ['T'] = 0x78, ['t'] = 0x78,
+    ['U'] = 0x3E, ['u'] = 0x1C, ['V'] = 0x3E, ['v'] = 0x1C,
+    ['W'] = 0x2A, ['w'] = 0x2A, ['X'] = 0x76, ['x'] = 0x76,
+    ['Y'] = 0x6E, ['y'] = 0x6E, ['Z'] = 0x5B, ['z'] = 0x5B,
+
+    [' '] = 0x00, ['-'] = 0x40, ['_'] = 0x08, ['='] = 0x48,
+    ['*'] = 0x63, ['\''] = 0x02, ['"'] = 0x22,
+    ['['] = 0x39, [']'] = 0x0F,
 };
 
 //?------------------------------------------------------------------------
 //?     GLOBALS
 //?------------------------------------------------------------------------
-static hal_map_t hex03_map;
-static hal_map_t hex45_map;
+static int hex03_ready = 0;
+static int hex45_ready = 0;
 
-static volatile uint32_t *hex03_ptr = NULL;
-static volatile uint32_t *hex45_ptr = NULL;
+// Last value written to each register word ([0] = HEX3_HEX0, [1] = HEX5_HEX4);
+// digit writes modify the shadow instead of reading the bus, and whole-word
+// updates skip unchanged words.
+uint32_t hex_display_shadow[2] = { 0, 0 };
 
 //?------------------------------------------------------------------------
 //?     INIT & CLOSE
@@ -45,19 +75,17 @@ static volatile uint32_t *hex45_ptr = NULL;
  * Purpose: Map and cache pointers for HEX0..HEX3 register block.
  * Params:  none
  * Returns: 0 on success; -1 on failure.
- * Side effects: Initializes internal static pointers for HEX0..HEX3.
+ * Side effects: Takes a reference on the shared LW bridge window and loads
+ *               the HEX3..HEX0 shadow word.
  * Preconditions: HAL must be available; safe to call once at startup.
  */
 
 int init_hex0_hex3(void) {
-    if (hal_open(&hex03_map) != 0) {
-        return -1;
-    }
-    hex03_ptr = (volatile uint32_t *)hal_get_virtual_addr(&hex03_map, HEX3_HEX0_BASE);
-    if (hex03_ptr == NULL) {
-        hal_close(&hex03_map);
+    if (hal_lw_acquire() != 0) {
         return -1;
     }
+    hex_display_shadow[0] = hal_read32(HAL_LW_REG(HEX3_HEX0_BASE));
+    hex03_ready = 1;
     return 0;
 }
 
@@ -66,19 +94,17 @@ int init_hex0_hex3(void) {
  * Purpose: Map and cache pointers for HEX4..HEX5 register block.
  * Params:  none
  * Returns: 0 on success; -1 on failure.
- * Side effects: Initializes internal static pointers for HEX4..HEX5.
+ * Side effects: Takes a reference on the shared LW bridge window and loads
+ *               the HEX5..HEX4 shadow word.
  * Preconditions: HAL must be available; safe to call once at startup.
  */
 
 int init_hex4_hex5(void) {
-    if (hal_open(&hex45_map) != 0) {
-        return -1;
-    }
-    hex45_ptr = (volatile uint32_t *)hal_get_virtual_addr(&hex45_map, HEX5_HEX4_BASE);
-    if (hex45_ptr == NULL) {
-        hal_close(&hex45_map);
+    if (hal_lw_acquire() != 0) {
         return -1;
     }
+    hex_display_shadow[1] = hal_read32(HAL_LW_REG(HEX5_HEX4_BASE));
+    hex45_ready = 1;
     return 0;
 }
 
@@ -87,12 +113,13 @@ int init_hex4_hex5(void) {
  * Purpose: Release resources associated with HEX0..HEX3 block if owned here.
  * Params:  none
  * Returns: 0 on success; -1 on failure.
- * Notes: If HAL lifetime is managed elsewhere, this may be a no-op.
+ * Notes: Drops the reference on the shared LW bridge window.
  */
 
 int close_hex0_hex3(void) {
-    hex03_ptr = NULL;
-    return hal_close(&hex03_map);
+    if (!hex03_ready) return -1;
+    hex03_ready = 0;
+    return hal_lw_release();
 }
 
 /*
@@ -100,12 +127,13 @@ int close_hex0_hex3(void) {
  * Purpose: Release resources associated with HEX4..HEX5 block if owned here.
  * Params:  none
  * Returns: 0 on success; -1 on failure.
- * Notes: If HAL lifetime is managed elsewhere, this may be a no-op.
+ * Notes: Drops the reference on the shared LW bridge window.
  */
 
 int close_hex4_hex5(void) {
-    hex45_ptr = NULL;
-    return hal_close(&hex45_map);
+    if (!hex45_ready) return -1;
+    hex45_ready = 0;
+    return hal_lw_release();
 }
 
 //?------------------------------------------------------------------------
@@ -116,31 +144,62 @@ int close_hex4_hex5(void) {
  * Purpose: Write a single 7-seg digit to a given HEX display.
  * Params:
  *   display - 0-5, where 0 is HEX0 and 5 is HEX5.
- *   value   - 0-15 logical digit; mapped through seg_table to segments.
+ *   value   - 0-15 logical digit, or HEX_BLANK; mapped through
+ *             hex_display_seg_table.
  * Returns:
  *   0 on success; -1 if display out of range or not initialized.
  * Side effects:
- *   Updates the corresponding bits in the HEX register.
+ *   Updates the corresponding bits in the HEX register (read-modify-write
+ *   against the driver's shadow copy, so no bus read is needed).
+ * Notes:
+ *   Checked wrapper around hex_display_write_inline.
  * Preconditions:
  *   init_hex0_hex3/init_hex4_hex5 previously succeeded.
  */
 
 int hex_display_write(int display, int value) {
-    if (value < 0 || value > 15) return -1;  // invalid digit
-    uint8_t seg_code = seg_table[value];
-
-    switch (display) {
-        case 0: *hex03_ptr = (*hex03_ptr & 0xFFFFFF00) | seg_code; break;
-        case 1: *hex03_ptr = (*hex03_ptr & 0xFFFF00FF) | (seg_code << 8); break;
-        case 2: *hex03_ptr = (*hex03_ptr & 0xFF00FFFF) | (seg_code << 16); break;
-        case 3: *hex03_ptr = (*hex03_ptr & 0x00FFFFFF) | (seg_code << 24); break;
-        case 4: *hex45_ptr = (*hex45_ptr & 0xFFFFFF00) | seg_code; break;
-        case 5: *hex45_ptr = (*hex45_ptr & 0xFFFF00FF) | (seg_code << 8); break;
-        default: return -1;
-    }
+    if (value < 0 || value > HEX_BLANK) return -1;  // invalid digit
+    if (display < 0 || display > 5) return -1;
+    if (!(display < 4 ? hex03_ready : hex45_ready)) return -1;
+
+    hex_display_write_inline(display, value);
     return 0;
 }
 
+/*
+ * hex_display_glyph
+ * Purpose: Look up the 7-seg segment code for a text character.
+ * Params:
+ *   c - ASCII character (letters, digits, blank, '-', '_', '=', '*' degree).
+ * Returns:
+ *   Segment byte; 0 (blank) for characters with no 7-segment form.
+ */
+
+int hex_display_glyph(char c) {
+    unsigned char uc = (unsigned char)c;
+    return uc < 128 ? glyph_table[uc] : 0;
+}
+
+/*
+ * hex_display_render_text
+ * Purpose: Build both register words for a short left-aligned word such
+ *          as "ALArn" or "SEt".
+ * Params:
+ *   text      - up to six characters; extra characters are ignored and
+ *               missing ones are blank.
+ *   hex3_hex0 - out parameter; word for HEX3..HEX0.
+ *   hex5_hex4 - out parameter; word for HEX5..HEX4.
+ * Returns: void
+ */
+
+void hex_display_render_text(const char *text, uint32_t *hex3_hex0, uint32_t *hex5_hex4) {
+    uint8_t window[HEX_DISPLAY_COUNT] = { 0 };
+    for (int i = 0; i < HEX_DISPLAY_COUNT && text[i]; i++) {
+        window[i] = (uint8_t)hex_display_glyph(text[i]);
+    }
+    hex_display_pack_window(window, hex3_hex0, hex5_hex4);
+}
+
 /*
  * hex_display_clear
  * Purpose: Blank a single HEX display.
@@ -149,12 +208,12 @@ int hex_display_write(int display, int value) {
  * Returns:
  *   0 on success; -1 on error.
  * Notes:
- *   Uses a blanking code that turns all segments off for that digit.
+ *   Writes HEX_BLANK, which turns all segments off for that digit.
  */
 
 
 int hex_display_clear(int display) {
-    return hex_display_write(display, 0x10); //* 0x10 = blank (not in seg_table)
+    return hex_display_write(display, HEX_BLANK);
 }
 
 /*
@@ -167,6 +226,8 @@ int hex_display_clear(int display) {
 
 
 void hex_display_clear_all(void) {
-    if (hex03_ptr) *hex03_ptr = 0;
-    if (hex45_ptr) *hex45_ptr = 0;
+    if (hex03_ready) hal_write32(HAL_LW_REG(HEX3_HEX0_BASE), 0);
+    if (hex45_ready) hal_write32(HAL_LW_REG(HEX5_HEX4_BASE), 0);
+    hex_display_shadow[0] = 0;
+    hex_display_shadow[1] = 0;
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <string.h>
+#include "../../includes/peripherals/hex-marquee.h"
+
+/*
+ * hex_marquee_init
+ * Purpose: Pre-render a message into the marquee strip.
+ * Params:
+ *   m    - marquee to initialize.
+ *   text - message; characters are mapped through hex_display_glyph.
+ * Returns:
+ *   0 on success; -1 if text is NULL or longer than HEX_MARQUEE_MAX_TEXT.
+ * Notes:
+ *   The message scrolls in from the right and out to the left, so a full
+ *   pass is strlen(text) + HEX_DISPLAY_COUNT + 1 frames, starting and
+ *   ending on a blank display.
+ */
+
+int hex_marquee_init(hex_marquee_t *m, const char *text) {
+    if (!m || !text) return -1;
+
+    size_t len = strlen(text);
+    if (len > HEX_MARQUEE_MAX_TEXT) return -1;
+
+    memset(m->strip, 0, sizeof(m->strip));
+    for (size_t i = 0; i < len; i++) {
+        m->strip[HEX_DISPLAY_COUNT + i] = (uint8_t)hex_display_glyph(text[i]);
+    }
+
+    m->steps = (int)len + HEX_DISPLAY_COUNT + 1;
+    return 0;
+}
+
+/*
+ * hex_marquee_frame
+ * Purpose: Register words for one window position.
+ * Params:
+ *   m         - initialized marquee.
+ *   step      - window position, taken modulo the pass length.
+ *   hex3_hex0 - out parameter; word for HEX3..HEX0.
+ *   hex5_hex4 - out parameter; word for HEX5..HEX4.
+ * Returns: void
+ */
+
+void hex_marquee_frame(const hex_marquee_t *m, int step, uint32_t *hex3_hex0, uint32_t *hex5_hex4) {
+    hex_display_pack_window(&m->strip[step % m->steps], hex3_hex0, hex5_hex4);
+}
@@ -0,0 +1,104 @@
+#include "../../includes/peripherals/key.h"
+#include "../../includes/hal/hal-api.h"
+#include <stdio.h>
+
+#include "../../lib/address_map_arm.h"
+#include "../../includes/hal/hal-regs.h"
+
+/*
+ * key_init
+ * Purpose: Initialize a pushbutton handle and discard presses latched
+ *          before startup.
+ * Params:
+ *   key - non-NULL pointer to key_handle_t to initialize.
+ * Returns:
+ *   0 on success; -1 on error.
+ * Side effects:
+ *   References the shared LW bridge window; sets key->reg_addr; clears the
+ *   edge-capture register; marks initialized.
+ */
+
+int key_init(key_handle_t *key) {
+    if (!key) return -1;
+    
+    // Reference the shared LW bridge window
+    if (hal_lw_acquire() != 0) {
+        fprintf(stderr, "Failed to initialize HAL for keys\n");
+        return -1;
+    }
+    
+    // Register address = LW bridge base + compile-time offset
+    key->reg_addr = (void *)HAL_LW_REG(KEY_BASE);
+    
+    key->initialized = 1;
+    
+    // Drop stale presses
+    hal_write32(HAL_LW_REG(KEY_EDGE_BASE), KEY_ALL_MASK);
+    
+    printf("Key peripheral initialized successfully at virtual address %p\n", key->reg_addr);
+    return 0;
+}
+
+/*
+ * key_cleanup
+ * Purpose: Mark key handle as uninitialized and release the HAL reference.
+ * Params:
+ *   key - pointer to key_handle_t.
+ * Returns:
+ *   0 on success; -1 on error.
+ */
+
+int key_cleanup(key_handle_t *key) {
+    if (!key || !key->initialized) return -1;
+    
+    key->reg_addr = NULL;
+    key->initialized = 0;
+    
+    // Drop this handle's reference on the shared LW bridge window
+    if (hal_lw_release() != 0) {
+        fprintf(stderr, "Failed to cleanup HAL\n");
+        return -1;
+    }
+    
+    printf("Key peripheral cleaned up successfully\n");
+    return 0;
+}
+
+/*
+ * key_read_all
+ * Purpose: Read the current (level) state of all pushbuttons.
+ * Params:
+ *   key       - initialized key handle.
+ *   key_state - out parameter; bit n set while KEYn is held.
+ * Returns:
+ *   0 on success; -1 on error.
+ */
+
+int key_read_all(key_handle_t *key, uint32_t *key_state) {
+    if (!key || !key->initialized || !key->reg_addr || !key_state) return -1;
+    
+    *key_state = hal_read32(HAL_LW_REG(KEY_BASE)) & KEY_ALL_MASK;
+    
+    return 0;
+}
+
+/*
+ * key_read_presses
+ * Purpose: Read and clear the presses latched since the last call.
+ * Params:
+ *   key     - initialized key handle.
+ *   presses - out parameter; bit n set if KEYn was pressed.
+ * Returns:
+ *   0 on success; -1 on error.
+ * Notes:
+ *   Checked wrapper around key_read_presses_inline. Presses are latched in
+ *   hardware, so none are lost between polls.
+ */
+
+int key_read_presses(key_handle_t *key, uint32_t *presses) {
+    if (!key || !key->initialized || !key->reg_addr || !presses) return -1;
+    
+    *presses = key_read_presses_inline(key);
+    
+    return 0;
+}
@@ -3,10 +3,7 @@
 #include <stdio.h>
 
 #include "../../lib/address_map_arm.h"
-
-// Global HAL mapping - shared across LED operations
-static hal_map_t hal_map;
-static int hal_initialized = 0;
+#include "../../includes/hal/hal-regs.h"
 
 /*
  * led_init
@@ -16,7 +13,7 @@ static int hal_initialized = 0;
  * Returns:
  *   0 on success; -1 on error.
  * Side effects:
- *   Opens HAL if needed; sets led->reg_addr; marks initialized.
+ *   References the shared LW bridge window; sets led->reg_addr; marks initialized.
  * Preconditions:
  *   led != NULL.
  */
@@ -24,22 +21,15 @@ static int hal_initialized = 0;
 int led_init(led_handle_t *led) {
     if (!led) return -1;
     
-    // Initialize HAL if not already done
-    if (!hal_initialized) {
-        if (hal_open(&hal_map) != 0) {
-            fprintf(stderr, "Failed to initialize HAL for LED\n");
-            return -1;
-        }
-        hal_initialized = 1;
-    }
-    
-    // Get virtual address for LED register (offset from LW bridge base)
-    led->reg_addr = hal_get_virtual_addr(&hal_map, LEDR_BASE);
-    if (!led->reg_addr) {
-        fprintf(stderr, "Failed to get LED register address\n");
+    // Reference the shared LW bridge window
+    if (hal_lw_acquire() != 0) {
+        fprintf(stderr, "Failed to initialize HAL for LED\n");
         return -1;
     }
     
+    // Register address = LW bridge base + compile-time offset
+    led->reg_addr = (void *)HAL_LW_REG(LEDR_BASE);
+    
     led->initialized = 1;
     
     // Initialize LEDs to off state
@@ -69,13 +59,10 @@ int led_cleanup(led_handle_t *led) {
     led->reg_addr = NULL;
     led->initialized = 0;
     
-    // Close HAL if this was the last LED user
-    if (hal_initialized) {
-        if (hal_close(&hal_map) != 0) {
-            fprintf(stderr, "Failed to cleanup HAL\n");
-            return -1;
-        }
-        hal_initialized = 0;
+    // Drop this handle's reference on the shared LW bridge window
+    if (hal_lw_release() != 0) {
+        fprintf(stderr, "Failed to cleanup HAL\n");
+        return -1;
     }
     
     printf("LED peripheral cleaned up successfully\n");
@@ -92,16 +79,15 @@ int led_cleanup(led_handle_t *led) {
  *   0 on success; -1 on error.
  * Preconditions:
  *   led != NULL and led->initialized == 1.
+ * Notes:
+ *   Checked wrapper around led_set_inline.
  */
 
 int led_set(led_handle_t *led, uint32_t pattern) {
     if (!led || !led->initialized || !led->reg_addr) return -1;
     
-    // Mask to ensure only valid LED bits are set (10 LEDs)
-    pattern &= LED_ALL_ON;
-    
-    // Write to LED register
-    *(volatile uint32_t *)led->reg_addr = pattern;
+    // Masks to the 10 LED bits and stores to LEDR_BASE
+    led_set_inline(led, pattern);
     
     return 0;
 }
@@ -121,9 +107,8 @@ int led_set(led_handle_t *led, uint32_t pattern) {
 int led_get(led_handle_t *led, uint32_t *pattern) {
     if (!led || !led->initialized || !led->reg_addr || !pattern) return -1;
     
-    // Read from LED register
-    *pattern = *(volatile uint32_t *)led->reg_addr;
-    *pattern &= LED_ALL_ON;
+    // Read from LED register (masked to the 10 LED bits)
+    *pattern = led_get_inline(led);
     
     return 0;
 }
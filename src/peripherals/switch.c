@@ -3,10 +3,7 @@
 #include <stdio.h>
 
 #include "../../lib/address_map_arm.h"
-
-// Global HAL mapping - shared across switch operations
-static hal_map_t hal_map;
-static int hal_initialized = 0;
+#include "../../includes/hal/hal-regs.h"
 
 /*
  * switch_init
@@ -16,28 +13,21 @@ static int hal_initialized = 0;
  * Returns:
  *   0 on success; -1 on error.
  * Side effects:
- *   Opens HAL if needed; sets sw->reg_addr; marks initialized.
+ *   References the shared LW bridge window; sets sw->reg_addr; marks initialized.
  */
 
 int switch_init(switch_handle_t *sw) {
     if (!sw) return -1;
     
-    // Initialize HAL if not already done
-    if (!hal_initialized) {
-        if (hal_open(&hal_map) != 0) {
-            fprintf(stderr, "Failed to initialize HAL for switches\n");
-            return -1;
-        }
-        hal_initialized = 1;
-    }
-    
-    // Get virtual address for switch register (offset from LW bridge base)
-    sw->reg_addr = hal_get_virtual_addr(&hal_map, SW_BASE);
-    if (!sw->reg_addr) {
-        fprintf(stderr, "Failed to get switch register address\n");
+    // Reference the shared LW bridge window
+    if (hal_lw_acquire() != 0) {
+        fprintf(stderr, "Failed to initialize HAL for switches\n");
         return -1;
     }
     
+    // Register address = LW bridge base + compile-time offset
+    sw->reg_addr = (void *)HAL_LW_REG(SW_BASE);
+    
     sw->initialized = 1;
     
     printf("Switch peripheral initialized successfully at virtual address %p\n", sw->reg_addr);
@@ -61,13 +51,10 @@ int switch_cleanup(switch_handle_t *sw) {
     sw->reg_addr = NULL;
     sw->initialized = 0;
     
-    // Close HAL if this was the last switch user
-    if (hal_initialized) {
-        if (hal_close(&hal_map) != 0) {
-            fprintf(stderr, "Failed to cleanup HAL\n");
-            return -1;
-        }
-        hal_initialized = 0;
+    // Drop this handle's reference on the shared LW bridge window
+    if (hal_lw_release() != 0) {
+        fprintf(stderr, "Failed to cleanup HAL\n");
+        return -1;
     }
     
     printf("Switch peripheral cleaned up successfully\n");
@@ -83,16 +70,15 @@ int switch_cleanup(switch_handle_t *sw) {
  *   0 on success; -1 on error.
  * Preconditions:
  *   switch_state != NULL; handle initialized.
+ * Notes:
+ *   Checked wrapper around switch_read_all_inline.
  */
 
 int switch_read_all(switch_handle_t *sw, uint32_t *switch_state) {
     if (!sw || !sw->initialized || !sw->reg_addr || !switch_state) return -1;
     
-    // Read from switch register
-    *switch_state = *(volatile uint32_t *)sw->reg_addr;
-    
-    // Mask to ensure only valid switch bits (10 switches)
-    *switch_state &= SWITCH_ALL_MASK;
+    // Read from switch register (masked to the 10 switch bits)
+    *switch_state = switch_read_all_inline(sw);
     
     return 0;
 }
@@ -0,0 +1,377 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../lib/address_map_arm.h"
+#include "../includes/hal/hal-regs.h"
+#include "../includes/hal/hal-trace.h"
+
+/*
+ * trace_tool
+ *   stat <trace>                         bus traffic summary per register
+ *   diff <ref> <cand> [--settle-us N] [--tolerance-us N]
+ *       compare the output register sequence (LEDR, HEX3..0, HEX5..4) and
+ *       its timing; exits 0 when equivalent, 1 when not, 2 on usage/I/O error.
+ *   inputs <out> <ms>:sw=<hex>|<ms>:key=<mask> ...
+ *       write a trace holding only the given SW/KEY reads, to drive a
+ *       HAL_REPLAY run without recording one on the board first.
+ *
+ *   Outputs are compared as settled states: accesses closer together than
+ *   the settle window form one burst (an input read starts a new one, as
+ *   the app samples inputs before each update), and only the values at the
+ *   end of each burst count. A driver that reaches the same display with
+ *   fewer or coalesced writes therefore still compares equal.
+ */
+
+//?------------------------------------------------------------------------
+//?     CONSTANTS
+//?------------------------------------------------------------------------
+#define DEFAULT_SETTLE_US      1000
+#define DEFAULT_TOLERANCE_US   20000
+#define OUTPUT_COUNT           3
+#define MAX_INPUT_EVENTS       256
+
+static const uint16_t output_offsets[OUTPUT_COUNT] = { LEDR_BASE, HEX3_HEX0_BASE, HEX5_HEX4_BASE };
+static const char *output_names[OUTPUT_COUNT] = { "LEDR", "HEX3_HEX0", "HEX5_HEX4" };
+
+typedef struct {
+    uint64_t t_ns;                 // relative to the first record
+    uint32_t regs[OUTPUT_COUNT];
+} frame_t;
+
+typedef struct {
+    unsigned long reads;
+    unsigned long writes;
+    unsigned long redundant;       // writes that stored the value already there
+} traffic_t;
+
+//?------------------------------------------------------------------------
+//?     ANALYSIS
+//?------------------------------------------------------------------------
+
+static int output_index(uint16_t offset) {
+    for (int i = 0; i < OUTPUT_COUNT; i++) {
+        if (output_offsets[i] == offset) return i;
+    }
+    return -1;
+}
+
+static const char *offset_name(uint16_t offset) {
+    switch (offset) {
+        case LEDR_BASE:       return "LEDR";
+        case HEX3_HEX0_BASE:  return "HEX3_HEX0";
+        case HEX5_HEX4_BASE:  return "HEX5_HEX4";
+        case SW_BASE:         return "SW";
+        case KEY_BASE:        return "KEY";
+        case KEY_EDGE_BASE:   return "KEY_EDGE";
+        default:              return "?";
+    }
+}
+
+/*
+ * build_frames
+ * Purpose: Reduce a trace to its sequence of distinct settled output states.
+ *          A burst ends on a gap longer than settle_ns, or when an input
+ *          is read after an output write: inputs are sampled at the top of
+ *          each update, so a late wakeup that catches up with back-to-back
+ *          updates still yields one state per update.
+ * Params:
+ *   rec, n    - trace records.
+ *   settle_ns - gap that ends a burst.
+ *   count     - out parameter; number of frames.
+ * Returns: malloc'd frame array (caller frees), or NULL on allocation failure.
+ */
+
+static frame_t *build_frames(const hal_trace_record_t *rec, size_t n, uint64_t settle_ns, size_t *count) {
+    frame_t *frames = malloc((n + 1) * sizeof(*frames));
+    if (!frames) return NULL;
+
+    uint32_t regs[OUTPUT_COUNT] = { 0 };
+    uint64_t last_write = 0;
+    int dirty = 0;
+    size_t k = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int idx = output_index(rec[i].offset);
+        if (rec[i].op == HAL_TRACE_WRITE && idx >= 0) {
+            regs[idx] = rec[i].value;
+            last_write = rec[i].timestamp_ns - rec[0].timestamp_ns;
+            dirty = 1;
+        }
+
+        int burst_end = (i + 1 == n) ||
+                        (rec[i + 1].timestamp_ns - rec[i].timestamp_ns > settle_ns) ||
+                        (rec[i + 1].op == HAL_TRACE_READ && output_index(rec[i + 1].offset) < 0);
+        if (dirty && burst_end) {
+            if (k == 0 || memcmp(frames[k - 1].regs, regs, sizeof(regs)) != 0) {
+                frames[k].t_ns = last_write;
+                memcpy(frames[k].regs, regs, sizeof(regs));
+                k++;
+            }
+            dirty = 0;
+        }
+    }
+
+    *count = k;
+    return frames;
+}
+
+/*
+ * skip_brief
+ * Purpose: Find how many states from frames[i] on can be stepped over to
+ *          reach one equal to other (within tolerance in value and time),
+ *          when all of them were replaced within tolerance_ns of frames[i].
+ * Returns: number of states to skip, or 0 if there is no such match.
+ */
+
+static size_t skip_brief(const frame_t *frames, size_t n, size_t i, const frame_t *other, uint64_t tolerance_ns) {
+    for (size_t k = i + 1; k < n && frames[k].t_ns - frames[i].t_ns <= tolerance_ns; k++) {
+        uint64_t skew = frames[k].t_ns > other->t_ns ? frames[k].t_ns - other->t_ns : other->t_ns - frames[k].t_ns;
+        if (memcmp(frames[k].regs, other->regs, sizeof(other->regs)) == 0 && skew <= tolerance_ns) return k - i;
+    }
+    return 0;
+}
+
+static traffic_t count_traffic(const hal_trace_record_t *rec, size_t n) {
+    traffic_t t = { 0, 0, 0 };
+    uint32_t last[OUTPUT_COUNT] = { 0 };
+    int seen[OUTPUT_COUNT] = { 0 };
+
+    for (size_t i = 0; i < n; i++) {
+        if (rec[i].op == HAL_TRACE_READ) {
+            t.reads++;
+            continue;
+        }
+        t.writes++;
+        int idx = output_index(rec[i].offset);
+        if (idx < 0) continue;
+        if (seen[idx] && last[idx] == rec[i].value) t.redundant++;
+        last[idx] = rec[i].value;
+        seen[idx] = 1;
+    }
+    return t;
+}
+
+//?------------------------------------------------------------------------
+//?     COMMANDS
+//?------------------------------------------------------------------------
+
+static int cmd_stat(const char *path) {
+    hal_trace_record_t *rec;
+    size_t n;
+    if (hal_trace_load(path, &rec, &n) != 0) return 2;
+
+    unsigned long reads[LW_BRIDGE_SPAN / 4] = { 0 };
+    unsigned long writes[LW_BRIDGE_SPAN / 4] = { 0 };
+    for (size_t i = 0; i < n; i++) {
+        if (rec[i].offset >= LW_BRIDGE_SPAN) continue;
+        if (rec[i].op == HAL_TRACE_READ) reads[rec[i].offset / 4]++;
+        else writes[rec[i].offset / 4]++;
+    }
+
+    double span_s = n ? (rec[n - 1].timestamp_ns - rec[0].timestamp_ns) / 1e9 : 0.0;
+    traffic_t t = count_traffic(rec, n);
+
+    printf("%s: %zu accesses over %.3f s\n", path, n, span_s);
+    printf("  %-10s %-8s %10s %10s\n", "register", "offset", "reads", "writes");
+    for (unsigned int w = 0; w < LW_BRIDGE_SPAN / 4; w++) {
+        if (!reads[w] && !writes[w]) continue;
+        printf("  %-10s 0x%04X   %10lu %10lu\n", offset_name(w * 4), w * 4, reads[w], writes[w]);
+    }
+    printf("  total: %lu reads, %lu writes (%lu redundant output writes)\n",
+           t.reads, t.writes, t.redundant);
+
+    free(rec);
+    return 0;
+}
+
+static void print_frame(const char *label, const frame_t *f) {
+    printf("    %-4s t=%10.3f ms", label, f->t_ns / 1e6);
+    for (int i = 0; i < OUTPUT_COUNT; i++) printf("  %s=0x%08X", output_names[i], f->regs[i]);
+    printf("\n");
+}
+
+static int cmd_diff(const char *ref_path, const char *cand_path, uint64_t settle_ns, uint64_t tolerance_ns) {
+    hal_trace_record_t *ref, *cand;
+    size_t ref_n, cand_n;
+    if (hal_trace_load(ref_path, &ref, &ref_n) != 0) return 2;
+    if (hal_trace_load(cand_path, &cand, &cand_n) != 0) {
+        free(ref);
+        return 2;
+    }
+
+    size_t ref_frames_n, cand_frames_n;
+    frame_t *ref_frames = build_frames(ref, ref_n, settle_ns, &ref_frames_n);
+    frame_t *cand_frames = build_frames(cand, cand_n, settle_ns, &cand_frames_n);
+    if (!ref_frames || !cand_frames) {
+        fprintf(stderr, "ERROR: out of memory\n");
+        free(ref_frames);
+        free(cand_frames);
+        free(ref);
+        free(cand);
+        return 2;
+    }
+
+    // Runs are cut by a signal at slightly different moments, so states
+    // produced within the tolerance of the shorter run's end are not compared.
+    uint64_t ref_len = ref_n ? ref[ref_n - 1].timestamp_ns - ref[0].timestamp_ns : 0;
+    uint64_t cand_len = cand_n ? cand[cand_n - 1].timestamp_ns - cand[0].timestamp_ns : 0;
+    uint64_t shorter = ref_len < cand_len ? ref_len : cand_len;
+    uint64_t horizon = shorter > tolerance_ns ? shorter - tolerance_ns : 0;
+
+    // Walk both runs while either still has a state before the horizon. A
+    // state shown for less than the tolerance may be missing from the other
+    // run: a late wakeup can step straight past it, just as it skews timing.
+    int equal = 1;
+    uint64_t worst_skew = 0;
+    size_t i = 0, j = 0, common = 0, skipped = 0, skip;
+
+    while (i < ref_frames_n && j < cand_frames_n &&
+           (ref_frames[i].t_ns < horizon || cand_frames[j].t_ns < horizon)) {
+        const frame_t *a = &ref_frames[i];
+        const frame_t *b = &cand_frames[j];
+        uint64_t skew = a->t_ns > b->t_ns ? a->t_ns - b->t_ns : b->t_ns - a->t_ns;
+        if (memcmp(a->regs, b->regs, sizeof(a->regs)) == 0 && skew <= tolerance_ns) {
+            if (skew > worst_skew) worst_skew = skew;
+            i++;
+            j++;
+            common++;
+        } else if ((skip = skip_brief(ref_frames, ref_frames_n, i, b, tolerance_ns)) > 0) {
+            i += skip;
+            skipped += skip;
+        } else if ((skip = skip_brief(cand_frames, cand_frames_n, j, a, tolerance_ns)) > 0) {
+            j += skip;
+            skipped += skip;
+        } else {
+            printf("  mismatch at output state %zu:\n", common);
+            print_frame("ref", a);
+            print_frame("cand", b);
+            equal = 0;
+            break;
+        }
+    }
+    if (equal && ((i < ref_frames_n && ref_frames[i].t_ns < horizon) ||
+                  (j < cand_frames_n && cand_frames[j].t_ns < horizon))) {
+        printf("  output states run out early: ref %zu of %zu, cand %zu of %zu\n",
+               i, ref_frames_n, j, cand_frames_n);
+        equal = 0;
+    }
+
+    traffic_t ta = count_traffic(ref, ref_n);
+    traffic_t tb = count_traffic(cand, cand_n);
+
+    printf("output states: %zu compared (ref %zu, cand %zu total, %zu brief ones in one run only); "
+           "worst timing skew %.3f ms (tolerance %.3f ms)\n",
+           common, ref_frames_n, cand_frames_n, skipped, worst_skew / 1e6, tolerance_ns / 1e6);
+    printf("bus traffic:   ref %lu reads / %lu writes, cand %lu reads / %lu writes\n",
+           ta.reads, ta.writes, tb.reads, tb.writes);
+    if (ta.reads + ta.writes > 0) {
+        long before = (long)(ta.reads + ta.writes);
+        long after = (long)(tb.reads + tb.writes);
+        printf("               %+.1f%% accesses\n", 100.0 * (after - before) / before);
+    }
+    printf("%s\n", equal ? "EQUIVALENT" : "DIFFERENT");
+
+    free(ref_frames);
+    free(cand_frames);
+    free(ref);
+    free(cand);
+    return equal ? 0 : 1;
+}
+
+static int cmd_inputs(const char *path, char **events, int event_count) {
+    if (event_count > MAX_INPUT_EVENTS) {
+        fprintf(stderr, "trace_tool: at most %d input events\n", MAX_INPUT_EVENTS);
+        return 2;
+    }
+
+    // Replay places a change between the read that saw it and the one
+    // before, so each event is preceded by a read of the old value 1 us
+    // earlier to pin it to the time given.
+    hal_trace_record_t rec[2 * MAX_INPUT_EVENTS];
+    size_t n = 0;
+    uint64_t last_ns = 0;
+    uint32_t sw_value = 0;
+    int sw_seen = 0;
+    for (int i = 0; i < event_count; i++) {
+        unsigned long ms;
+        char reg[4];
+        unsigned int value;
+        if (sscanf(events[i], "%lu:%3[a-z]=%x", &ms, reg, &value) != 3 ||
+            (strcmp(reg, "sw") != 0 && strcmp(reg, "key") != 0)) {
+            fprintf(stderr, "trace_tool: bad input event '%s'\n", events[i]);
+            return 2;
+        }
+        uint64_t t_ns = (uint64_t)ms * 1000000ull;
+        if (i > 0 && t_ns <= last_ns) {
+            fprintf(stderr, "trace_tool: input events must be at increasing times\n");
+            return 2;
+        }
+        last_ns = t_ns;
+
+        // A press reads as the KEY edge-capture bits the board latched
+        int key = strcmp(reg, "key") == 0;
+        uint16_t offset = key ? KEY_EDGE_BASE : SW_BASE;
+        if (t_ns > 0 && (key || sw_seen)) {
+            rec[n++] = (hal_trace_record_t){ t_ns - 1000, key ? 0 : sw_value, offset, HAL_TRACE_READ, 0 };
+        }
+        rec[n++] = (hal_trace_record_t){ t_ns, key ? value & 0xF : value, offset, HAL_TRACE_READ, 0 };
+        if (!key) {
+            sw_value = value;
+            sw_seen = 1;
+        }
+    }
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "trace_tool: cannot create %s\n", path);
+        return 2;
+    }
+    hal_trace_header_t hdr = { HAL_TRACE_MAGIC, HAL_TRACE_VERSION, sizeof(hal_trace_record_t),
+                               LW_BRIDGE_SPAN, 0 };
+    int ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+             fwrite(rec, sizeof(rec[0]), n, f) == n;
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "trace_tool: write to %s failed\n", path);
+        return 2;
+    }
+    return 0;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: trace_tool stat <trace>\n"
+            "       trace_tool diff <ref> <cand> [--settle-us N] [--tolerance-us N]\n"
+            "       trace_tool inputs <out> <ms>:sw=<hex>|<ms>:key=<mask> ...\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "stat") == 0) {
+        return cmd_stat(argv[2]);
+    }
+
+    if (argc >= 4 && strcmp(argv[1], "diff") == 0) {
+        uint64_t settle_us = DEFAULT_SETTLE_US;
+        uint64_t tolerance_us = DEFAULT_TOLERANCE_US;
+        for (int i = 4; i < argc; i++) {
+            if (strcmp(argv[i], "--settle-us") == 0 && i + 1 < argc) {
+                settle_us = strtoull(argv[++i], NULL, 10);
+            } else if (strcmp(argv[i], "--tolerance-us") == 0 && i + 1 < argc) {
+                tolerance_us = strtoull(argv[++i], NULL, 10);
+            } else {
+                usage();
+                return 2;
+            }
+        }
+        return cmd_diff(argv[2], argv[3], settle_us * 1000, tolerance_us * 1000);
+    }
+
+    if (argc >= 4 && strcmp(argv[1], "inputs") == 0) {
+        return cmd_inputs(argv[2], argv + 3, argc - 3);
+    }
+
+    usage();
+    return 2;
+}